@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// The cost of connecting and starting an exec::any_sender_of, including the type erasure of
+// the sender, against connecting and starting the sender it erases.
+
+#include "benchmark.hpp"
+
+#include <exec/any_sender_of.hpp>
+
+#include <cstdint>
+
+using namespace stdexec;
+
+namespace {
+  using any_int_sender =
+    exec::any_receiver_ref<completion_signatures<set_value_t(std::int64_t)>>::any_sender<>;
+
+  void any_sender_baseline(bench::state& state) {
+    for (std::int64_t i = 0; i < state.iterations; ++i) {
+      auto op = connect(just(i), bench::sink_receiver{});
+      start(op);
+      bench::do_not_optimize(op);
+    }
+  }
+
+  STDEXEC_BENCHMARK(any_sender_baseline);
+
+  void any_sender_connect(bench::state& state) {
+    for (std::int64_t i = 0; i < state.iterations; ++i) {
+      any_int_sender sndr = just(i);
+      auto op = connect(std::move(sndr), bench::sink_receiver{});
+      start(op);
+    }
+  }
+
+  STDEXEC_BENCHMARK(any_sender_connect);
+} // namespace
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// The throughput of exec::async_scope: spawning work that completes inline or on a thread
+// pool, and nesting and completing operations in one scope from a number of threads at once,
+// for exec::async_scope and exec::sharded_async_scope.
+
+#include "benchmark.hpp"
+
+#include <exec/async_scope.hpp>
+#include <exec/static_thread_pool.hpp>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace stdexec;
+
+namespace {
+  void async_scope_spawn_inline(bench::state& state) {
+    exec::async_scope scope;
+    for (std::int64_t i = 0; i < state.iterations; ++i) {
+      scope.spawn(just());
+    }
+    sync_wait(scope.on_empty());
+  }
+
+  STDEXEC_BENCHMARK(async_scope_spawn_inline);
+
+  void async_scope_spawn_static_thread_pool(bench::state& state) {
+    exec::static_thread_pool pool{static_cast<std::uint32_t>(state.arg)};
+    auto sch = pool.get_scheduler();
+    exec::async_scope scope;
+    state.start();
+    for (std::int64_t i = 0; i < state.iterations; ++i) {
+      scope.spawn(schedule(sch));
+    }
+    sync_wait(scope.on_empty());
+    state.stop();
+  }
+
+  STDEXEC_BENCHMARK(async_scope_spawn_static_thread_pool, 1, 4);
+
+  // state.arg threads nest state.iterations operations each.
+  template <class Scope>
+  void nest_from_threads(bench::state& state) {
+    Scope scope;
+    std::vector<std::thread> threads;
+    for (std::int64_t t = 0; t < state.arg; ++t) {
+      threads.emplace_back([&] {
+        for (std::int64_t i = 0; i < state.iterations; ++i) {
+          auto op = connect(scope.nest(just()), bench::sink_receiver{});
+          stdexec::start(op);
+        }
+      });
+    }
+    for (auto& thread: threads) {
+      thread.join();
+    }
+    state.stop();
+    sync_wait(scope.on_empty());
+    state.items = state.arg * state.iterations;
+  }
+
+  void async_scope_nest(bench::state& state) {
+    nest_from_threads<exec::async_scope>(state);
+  }
+
+  STDEXEC_BENCHMARK(async_scope_nest, 1, 2, 4, 8);
+
+  void sharded_async_scope_nest(bench::state& state) {
+    nest_from_threads<exec::sharded_async_scope>(state);
+  }
+
+  STDEXEC_BENCHMARK(sharded_async_scope_nest, 1, 2, 4, 8);
+} // namespace
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <stdexec/execution.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <string>
+#include <vector>
+
+// A minimal microbenchmark harness for stdexec.benchmarks.
+//
+// A benchmark is a function void(bench::state&) that performs the measured
+// operation state.iterations times. The driver calls it with a growing number
+// of iterations until a run takes at least the minimum time, and reports the
+// time per item of that run, where items defaults to the iterations.
+//
+//   void schedule_inline(bench::state& state) {
+//     for (std::int64_t i = 0; i < state.iterations; ++i) { ... }
+//   }
+//   STDEXEC_BENCHMARK(schedule_inline);
+//
+// Extra arguments to STDEXEC_BENCHMARK register one run per value, passed in
+// state.arg and appended to the name, as in "when_all_just/8".
+namespace bench {
+  using clock = std::chrono::steady_clock;
+
+  struct state {
+    std::int64_t iterations;
+    std::int64_t arg;
+    // The number of items the run processed, for the time per item.
+    std::int64_t items;
+    clock::time_point start_time;
+    std::optional<clock::time_point> stop_time;
+    const char* skipped = nullptr;
+    const char* failed = nullptr;
+
+    // Excludes the setup before the call from the measurement.
+    void start() noexcept {
+      start_time = clock::now();
+    }
+
+    // Excludes the teardown after the call from the measurement.
+    void stop() noexcept {
+      stop_time = clock::now();
+    }
+
+    // Reports that the benchmark cannot run here, for example for lack of a kernel feature.
+    void skip(const char* reason) noexcept {
+      skipped = reason;
+    }
+
+    // Reports that the benchmark computed a wrong result. The driver exits with a failure.
+    void fail(const char* reason) noexcept {
+      failed = reason;
+    }
+  };
+
+  using function_t = void (*)(state&);
+
+  struct benchmark {
+    std::string name;
+    function_t function;
+    std::optional<std::int64_t> arg;
+  };
+
+  inline std::vector<benchmark>& registry() {
+    static std::vector<benchmark> benchmarks;
+    return benchmarks;
+  }
+
+  struct registrar {
+    registrar(const char* name, function_t function, std::initializer_list<std::int64_t> args) {
+      if (args.size() == 0) {
+        registry().push_back({name, function, std::nullopt});
+      }
+      for (std::int64_t arg: args) {
+        registry().push_back({std::string(name) + "/" + std::to_string(arg), function, arg});
+      }
+    }
+  };
+
+  // Accepts and discards any completion.
+  struct sink_receiver {
+    using is_receiver = void;
+
+    template <class... As>
+    friend void tag_invoke(stdexec::set_value_t, sink_receiver&&, As&&...) noexcept {
+    }
+
+    template <class Error>
+    friend void tag_invoke(stdexec::set_error_t, sink_receiver&&, Error&&) noexcept {
+    }
+
+    friend void tag_invoke(stdexec::set_stopped_t, sink_receiver&&) noexcept {
+    }
+
+    friend stdexec::empty_env tag_invoke(stdexec::get_env_t, const sink_receiver&) noexcept {
+      return {};
+    }
+  };
+
+  // Keeps the optimizer from discarding a value that is otherwise unused.
+  template <class T>
+  void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static const void* volatile sink;
+    sink = &value;
+#endif
+  }
+} // namespace bench
+
+#define STDEXEC_BENCHMARK(function, ...)                                                           \
+  static const ::bench::registrar STDEXEC_CAT(__bench_registrar_, function) {                      \
+    #function, function, { __VA_ARGS__ }                                                           \
+  }
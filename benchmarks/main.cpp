@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// The driver of stdexec.benchmarks.
+//
+//   stdexec.benchmarks [--filter=<substring>] [--min-time=<seconds>] [--format=console|json]
+//                      [--out=<file>] [--list]
+//
+// --format=json prints the results as JSON in the layout of Google Benchmark's JSON reporter
+// (a "context" object and a "benchmarks" array, with real_time in nanoseconds per item), so
+// that results can be tracked and compared across releases with the usual tools. --out
+// additionally writes the JSON to a file. The driver exits with a failure if a benchmark
+// reports a wrong result with state.fail().
+
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+  struct options {
+    std::string filter;
+    double min_time = 0.5;
+    bool json = false;
+    std::string out;
+    bool list = false;
+  };
+
+  struct result {
+    std::string name;
+    std::int64_t iterations;
+    std::int64_t items;
+    double seconds;
+    const char* skipped;
+    const char* failed;
+
+    double ns_per_item() const {
+      return seconds * 1e9 / static_cast<double>(items);
+    }
+
+    double items_per_second() const {
+      return static_cast<double>(items) / seconds;
+    }
+  };
+
+  bool parse_option(std::string_view arg, std::string_view name, std::string_view& value) {
+    if (arg.substr(0, name.size()) != name || arg.size() <= name.size()
+        || arg[name.size()] != '=') {
+      return false;
+    }
+    value = arg.substr(name.size() + 1);
+    return true;
+  }
+
+  options parse_options(int argc, char** argv) {
+    options opts;
+    for (int i = 1; i < argc; ++i) {
+      std::string_view arg = argv[i];
+      std::string_view value;
+      if (parse_option(arg, "--filter", value)) {
+        opts.filter = value;
+      } else if (parse_option(arg, "--min-time", value)) {
+        opts.min_time = std::atof(std::string(value).c_str());
+      } else if (parse_option(arg, "--format", value)) {
+        opts.json = value == "json";
+      } else if (parse_option(arg, "--out", value)) {
+        opts.out = value;
+      } else if (arg == "--list") {
+        opts.list = true;
+      } else {
+        std::cerr << "stdexec.benchmarks: unknown option " << arg << '\n';
+        std::exit(EXIT_FAILURE);
+      }
+    }
+    return opts;
+  }
+
+  result run_once(const bench::benchmark& b, std::int64_t iterations) {
+    bench::state state{iterations, b.arg.value_or(0), iterations, bench::clock::now()};
+    b.function(state);
+    auto stop_time = state.stop_time.value_or(bench::clock::now());
+    std::chrono::duration<double> elapsed = stop_time - state.start_time;
+    return {b.name, iterations, state.items, elapsed.count(), state.skipped, state.failed};
+  }
+
+  // Grows the number of iterations until a run takes at least min_time.
+  result run(const bench::benchmark& b, double min_time) {
+    constexpr std::int64_t max_iterations = 1'000'000'000;
+    std::int64_t iterations = 1;
+    for (;;) {
+      result r = run_once(b, iterations);
+      double seconds = r.seconds;
+      if (r.skipped || r.failed || seconds >= min_time || iterations == max_iterations) {
+        return r;
+      }
+      // Aim a little past min_time, growing by at most 10x per step.
+      double factor = seconds > 0 ? 1.4 * min_time / seconds : 10.0;
+      factor = factor > 10.0 ? 10.0 : factor;
+      std::int64_t next = static_cast<std::int64_t>(static_cast<double>(iterations) * factor);
+      iterations = std::clamp(next, iterations + 1, max_iterations);
+    }
+  }
+
+  std::string json_escape(std::string_view str) {
+    std::string escaped;
+    for (char c: str) {
+      if (c == '"' || c == '\\') {
+        escaped += '\\';
+      }
+      escaped += c;
+    }
+    return escaped;
+  }
+
+  std::string to_json(const std::vector<result>& results) {
+    char date[64];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+
+    std::ostringstream json;
+    json.precision(17);
+    json << "{\n";
+    json << "  \"context\": {\n";
+    json << "    \"date\": \"" << date << "\",\n";
+    json << "    \"executable\": \"stdexec.benchmarks\",\n";
+    json << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+#ifdef NDEBUG
+    json << "    \"library_build_type\": \"release\"\n";
+#else
+    json << "    \"library_build_type\": \"debug\"\n";
+#endif
+    json << "  },\n";
+    json << "  \"benchmarks\": [";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+      const result& r = results[i];
+      json << (i == 0 ? "\n" : ",\n");
+      json << "    {\n";
+      json << "      \"name\": \"" << json_escape(r.name) << "\",\n";
+      json << "      \"run_name\": \"" << json_escape(r.name) << "\",\n";
+      json << "      \"run_type\": \"iteration\",\n";
+      if (r.skipped || r.failed) {
+        json << "      \"error_occurred\": true,\n";
+        json << "      \"error_message\": \"" << json_escape(r.skipped ? r.skipped : r.failed)
+             << "\"\n";
+        json << "    }";
+        continue;
+      }
+      json << "      \"iterations\": " << r.iterations << ",\n";
+      json << "      \"items\": " << r.items << ",\n";
+      json << "      \"real_time\": " << r.ns_per_item() << ",\n";
+      json << "      \"time_unit\": \"ns\",\n";
+      json << "      \"items_per_second\": " << r.items_per_second() << "\n";
+      json << "    }";
+    }
+    json << "\n  ]\n}\n";
+    return json.str();
+  }
+} // namespace
+
+int main(int argc, char** argv) {
+  options opts = parse_options(argc, argv);
+  std::vector<result> results;
+  bool failed = false;
+  for (const bench::benchmark& b: bench::registry()) {
+    if (b.name.find(opts.filter) == std::string::npos) {
+      continue;
+    }
+    if (opts.list) {
+      std::cout << b.name << '\n';
+      continue;
+    }
+    results.push_back(run(b, opts.min_time));
+    failed = failed || results.back().failed;
+    if (!opts.json) {
+      const result& r = results.back();
+      if (r.skipped) {
+        std::printf("%-44s skipped: %s\n", r.name.c_str(), r.skipped);
+        continue;
+      }
+      if (r.failed) {
+        std::printf("%-44s FAILED: %s\n", r.name.c_str(), r.failed);
+        continue;
+      }
+      std::printf(
+        "%-44s %14lld iterations %14.2f ns/item %14.4g items/s\n",
+        r.name.c_str(),
+        static_cast<long long>(r.iterations),
+        r.ns_per_item(),
+        r.items_per_second());
+      std::fflush(stdout);
+    }
+  }
+  if (opts.list) {
+    return 0;
+  }
+  std::string json = to_json(results);
+  if (opts.json) {
+    std::cout << json;
+  }
+  if (!opts.out.empty()) {
+    std::ofstream out(opts.out);
+    out << json;
+    if (!out) {
+      std::cerr << "stdexec.benchmarks: cannot write " << opts.out << '\n';
+      return EXIT_FAILURE;
+    }
+  }
+  if (failed) {
+    std::cerr << "stdexec.benchmarks: some benchmarks computed wrong results\n";
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// The cost of an iteration of exec::repeat_effect_until, for a source that completes
+// synchronously and for one that completes on a thread pool.
+
+#include "benchmark.hpp"
+
+#include <exec/repeat_effect_until.hpp>
+#include <exec/static_thread_pool.hpp>
+
+#include <cstdint>
+
+using namespace stdexec;
+
+namespace {
+  void repeat_effect_until_inline(bench::state& state) {
+    std::int64_t n = 0;
+    std::int64_t count = state.iterations;
+    sync_wait(exec::repeat_effect_until(just() | then([&n, count] { return ++n >= count; })));
+  }
+
+  STDEXEC_BENCHMARK(repeat_effect_until_inline);
+
+  void repeat_effect_until_static_thread_pool(bench::state& state) {
+    exec::static_thread_pool pool{1};
+    std::int64_t n = 0;
+    std::int64_t count = state.iterations;
+    state.start();
+    sync_wait(exec::repeat_effect_until(
+      schedule(pool.get_scheduler()) | then([&n, count] { return ++n >= count; })));
+    state.stop();
+  }
+
+  STDEXEC_BENCHMARK(repeat_effect_until_static_thread_pool);
+} // namespace
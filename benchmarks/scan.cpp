@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// The time per element of an in-place inclusive scan of state.arg 64-bit integers, run
+// inline and on a thread pool with a thread per core. Each iteration scans the result of the
+// previous one, so the integers are unsigned, which makes their overflow well-defined.
+
+#include "benchmark.hpp"
+
+#include <exec/scan.hpp>
+#include <exec/static_thread_pool.hpp>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+using namespace stdexec;
+
+namespace {
+  void inclusive_scan_inline(bench::state& state) {
+    std::vector<std::uint64_t> data(static_cast<std::size_t>(state.arg), 1);
+    state.start();
+    for (std::int64_t i = 0; i < state.iterations; ++i) {
+      sync_wait(just(std::span{data}) | exec::inclusive_scan());
+    }
+    state.stop();
+    bench::do_not_optimize(data.back());
+    state.items = state.iterations * state.arg;
+  }
+
+  STDEXEC_BENCHMARK(inclusive_scan_inline, 1 << 16, 1 << 24);
+
+  void inclusive_scan_static_thread_pool(bench::state& state) {
+    exec::static_thread_pool pool;
+    std::vector<std::uint64_t> data(static_cast<std::size_t>(state.arg), 1);
+    state.start();
+    for (std::int64_t i = 0; i < state.iterations; ++i) {
+      sync_wait(transfer_just(pool.get_scheduler(), std::span{data}) | exec::inclusive_scan());
+    }
+    state.stop();
+    bench::do_not_optimize(data.back());
+    state.items = state.iterations * state.arg;
+  }
+
+  STDEXEC_BENCHMARK(inclusive_scan_static_thread_pool, 1 << 16, 1 << 24);
+} // namespace
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// The cost of schedule and start on each execution context. For the contexts that run on
+// their own threads this is the round trip of sync_wait(schedule(sch)); run_loop has no
+// thread of its own, so its operations are started in batches and then run.
+
+#include "benchmark.hpp"
+
+#include <exec/inline_scheduler.hpp>
+#include <exec/single_thread_context.hpp>
+#include <exec/static_thread_pool.hpp>
+
+#if __has_include(<linux/io_uring.h>)
+#include <exec/linux/io_uring_context.hpp>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace stdexec;
+
+namespace {
+  template <class Scheduler>
+  void round_trips(std::int64_t iterations, Scheduler sch) {
+    for (std::int64_t i = 0; i < iterations; ++i) {
+      sync_wait(schedule(sch));
+    }
+  }
+
+  void schedule_inline_scheduler(bench::state& state) {
+    round_trips(state.iterations, exec::inline_scheduler{});
+  }
+
+  STDEXEC_BENCHMARK(schedule_inline_scheduler);
+
+  void schedule_run_loop(bench::state& state) {
+    using scheduler_t = decltype(std::declval<run_loop&>().get_scheduler());
+    using op_t = connect_result_t<schedule_result_t<scheduler_t>, bench::sink_receiver>;
+    constexpr std::int64_t batch_size = 1024;
+    std::vector<std::optional<op_t>> ops(batch_size);
+    for (std::int64_t done = 0; done < state.iterations; done += batch_size) {
+      run_loop loop;
+      std::int64_t count = std::min(batch_size, state.iterations - done);
+      for (std::int64_t i = 0; i < count; ++i) {
+        ops[i].emplace(__conv{[&] {
+          return connect(schedule(loop.get_scheduler()), bench::sink_receiver{});
+        }});
+        start(*ops[i]);
+      }
+      loop.finish();
+      loop.run();
+    }
+  }
+
+  STDEXEC_BENCHMARK(schedule_run_loop);
+
+  void schedule_single_thread_context(bench::state& state) {
+    exec::single_thread_context context;
+    state.start();
+    round_trips(state.iterations, context.get_scheduler());
+    state.stop();
+  }
+
+  STDEXEC_BENCHMARK(schedule_single_thread_context);
+
+  void schedule_static_thread_pool(bench::state& state) {
+    exec::static_thread_pool pool{static_cast<std::uint32_t>(state.arg)};
+    state.start();
+    round_trips(state.iterations, pool.get_scheduler());
+    state.stop();
+  }
+
+  STDEXEC_BENCHMARK(schedule_static_thread_pool, 1, 4);
+
+#if __has_include(<linux/io_uring.h>)
+  void schedule_io_uring_context(bench::state& state) {
+    std::optional<exec::io_uring_context> context_storage;
+    try {
+      context_storage.emplace();
+    } catch (const std::system_error&) {
+      state.skip("io_uring is not available");
+      return;
+    }
+    exec::io_uring_context& context = *context_storage;
+    std::thread io_thread{[&] {
+      context.run();
+    }};
+    state.start();
+    round_trips(state.iterations, context.get_scheduler());
+    state.stop();
+    context.request_stop();
+    io_thread.join();
+  }
+
+  STDEXEC_BENCHMARK(schedule_io_uring_context);
+#endif
+} // namespace
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// The time per element of exec::sort on state.arg shuffled 64-bit integers, run inline and
+// on a thread pool with a thread per core. Each iteration sorts a fresh copy of the input,
+// and the copy is part of the measurement.
+
+#include "benchmark.hpp"
+
+#include <exec/inline_scheduler.hpp>
+#include <exec/sort.hpp>
+#include <exec/static_thread_pool.hpp>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+using namespace stdexec;
+
+namespace {
+  std::vector<std::int64_t> shuffled(std::int64_t n) {
+    std::vector<std::int64_t> result(static_cast<std::size_t>(n));
+    std::uint64_t x = 88172645463325252ull;
+    for (auto& value: result) {
+      x ^= x << 13;
+      x ^= x >> 7;
+      x ^= x << 17;
+      value = static_cast<std::int64_t>(x);
+    }
+    return result;
+  }
+
+  template <class Scheduler>
+  void sort_on(bench::state& state, Scheduler sch) {
+    const std::vector<std::int64_t> input = shuffled(state.arg);
+    std::vector<std::int64_t> data;
+    state.start();
+    for (std::int64_t i = 0; i < state.iterations; ++i) {
+      data = input;
+      sync_wait(exec::sort(sch, std::span{data}));
+    }
+    state.stop();
+    bench::do_not_optimize(data.front());
+    state.items = state.iterations * state.arg;
+  }
+
+  void sort_inline(bench::state& state) {
+    sort_on(state, exec::inline_scheduler{});
+  }
+
+  STDEXEC_BENCHMARK(sort_inline, 1 << 16, 1 << 22);
+
+  void sort_static_thread_pool(bench::state& state) {
+    exec::static_thread_pool pool;
+    sort_on(state, pool.get_scheduler());
+  }
+
+  STDEXEC_BENCHMARK(sort_static_thread_pool, 1 << 16, 1 << 22);
+} // namespace
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// The overhead of split and ensure_started over waiting for the sender they wrap. Both
+// allocate shared state and synchronize the completion with the waiting consumer.
+
+#include "benchmark.hpp"
+
+#include <cstdint>
+
+using namespace stdexec;
+
+namespace {
+  void split_baseline(bench::state& state) {
+    for (std::int64_t i = 0; i < state.iterations; ++i) {
+      auto [value] = sync_wait(just(i)).value();
+      bench::do_not_optimize(value);
+    }
+  }
+
+  STDEXEC_BENCHMARK(split_baseline);
+
+  void split_one_consumer(bench::state& state) {
+    for (std::int64_t i = 0; i < state.iterations; ++i) {
+      auto [value] = sync_wait(split(just(i))).value();
+      bench::do_not_optimize(value);
+    }
+  }
+
+  STDEXEC_BENCHMARK(split_one_consumer);
+
+  // state.arg consumers of one split sender.
+  void split_consumers(bench::state& state) {
+    for (std::int64_t i = 0; i < state.iterations; ++i) {
+      auto shared = split(just(i));
+      for (std::int64_t consumer = 0; consumer < state.arg; ++consumer) {
+        auto [value] = sync_wait(shared).value();
+        bench::do_not_optimize(value);
+      }
+    }
+  }
+
+  STDEXEC_BENCHMARK(split_consumers, 4);
+
+  void ensure_started_one_consumer(bench::state& state) {
+    for (std::int64_t i = 0; i < state.iterations; ++i) {
+      auto [value] = sync_wait(ensure_started(just(i))).value();
+      bench::do_not_optimize(value);
+    }
+  }
+
+  STDEXEC_BENCHMARK(ensure_started_one_consumer);
+} // namespace
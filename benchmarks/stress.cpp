@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// The stress workloads of stress.hpp on each execution context that is available.
+
+#include "stress.hpp"
+
+#include <exec/single_thread_context.hpp>
+#include <exec/static_thread_pool.hpp>
+
+#if __has_include(<linux/io_uring.h>)
+#include <exec/linux/io_uring_context.hpp>
+#endif
+
+#if STDEXEC_BENCHMARK_TBB
+#include <tbbexec/tbb_thread_pool.hpp>
+#endif
+
+#include <thread>
+
+namespace {
+  // The execution contexts with their default configuration: the thread pools use as many
+  // threads as the hardware supports.
+  struct static_thread_pool_context {
+    exec::static_thread_pool pool;
+
+    auto get_scheduler() {
+      return pool.get_scheduler();
+    }
+  };
+
+  using single_thread_context = exec::single_thread_context;
+
+#if __has_include(<linux/io_uring.h>)
+  // An io_uring_context with a thread that runs it.
+  struct io_uring_context {
+    exec::io_uring_context context;
+    std::thread thread{[this] {
+      context.run();
+    }};
+
+    ~io_uring_context() {
+      context.request_stop();
+      thread.join();
+    }
+
+    auto get_scheduler() {
+      return context.get_scheduler();
+    }
+  };
+#endif
+
+#if STDEXEC_BENCHMARK_TBB
+  struct tbb_thread_pool_context {
+    tbbexec::tbb_thread_pool pool;
+
+    auto get_scheduler() {
+      return pool.get_scheduler();
+    }
+  };
+#endif
+
+  const bool registered = [] {
+    bench::stress::register_stress_workloads<static_thread_pool_context>("static_thread_pool");
+    bench::stress::register_stress_workloads<single_thread_context>("single_thread_context");
+#if __has_include(<linux/io_uring.h>)
+    bench::stress::register_stress_workloads<io_uring_context>("io_uring_context");
+#endif
+#if STDEXEC_BENCHMARK_TBB
+    bench::stress::register_stress_workloads<tbb_thread_pool_context>("tbb_thread_pool");
+#endif
+    return true;
+  }();
+} // namespace
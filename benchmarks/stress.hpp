@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "benchmark.hpp"
+
+#include <exec/async_scope.hpp>
+#include <exec/repeat_effect_until.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+// Scheduler stress workloads, written against any stdexec::scheduler so that execution
+// contexts can be compared on the same machine:
+//
+//   skynet<Depth>(sch)          a tree of when_all, ten children per node, with a task per
+//                               node; sends the sum of the leaf numbers
+//   ping_pong(a, b, n)          n round trips between two schedulers
+//   fork_join(sch, shape, data) one bulk of the given shape, scheduled on sch
+//   spawn_storm(sch, scope, n)  n tasks spawned into an async_scope, each spawning another
+//                               task from its thread of execution
+//
+// register_stress_workloads<Context>(name) registers all of them with stdexec.benchmarks for
+// a context type that is default constructible and has get_scheduler().
+namespace bench::stress {
+  inline constexpr std::size_t skynet_width = 10;
+
+  template <int Depth, stdexec::scheduler Scheduler>
+  auto skynet_node(Scheduler sch, std::int64_t num);
+
+  template <int Depth, class Scheduler, std::size_t... Is>
+  auto skynet_children(Scheduler sch, std::int64_t num, std::index_sequence<Is...>) {
+    return stdexec::when_all(
+             skynet_node<Depth>(sch, num * std::int64_t{skynet_width} + std::int64_t{Is})...)
+         | stdexec::then([](auto... sums) { return (sums + ...); });
+  }
+
+  // Inner nodes start eagerly and keep their operation state on the heap, so that the tree
+  // is not one operation state with a leaf per node.
+  template <int Depth, stdexec::scheduler Scheduler>
+  auto skynet_node(Scheduler sch, std::int64_t num) {
+    if constexpr (Depth == 0) {
+      return stdexec::schedule(sch) | stdexec::then([num] { return num; });
+    } else {
+      return stdexec::ensure_started(
+        stdexec::schedule(sch) | stdexec::let_value([sch, num] {
+          return skynet_children<Depth - 1>(sch, num, std::make_index_sequence<skynet_width>{});
+        }));
+    }
+  }
+
+  // The number of tasks in a tree of the given depth.
+  constexpr std::int64_t skynet_tasks(int depth) {
+    std::int64_t tasks = 1;
+    std::int64_t level = 1;
+    for (int i = 0; i < depth; ++i) {
+      level *= static_cast<std::int64_t>(skynet_width);
+      tasks += level;
+    }
+    return tasks;
+  }
+
+  template <int Depth, stdexec::scheduler Scheduler>
+  std::int64_t skynet(Scheduler sch) {
+    auto [sum] = stdexec::sync_wait(skynet_node<Depth>(sch, 0)).value();
+    return sum;
+  }
+
+  template <stdexec::scheduler First, stdexec::scheduler Second>
+  void ping_pong(First first, Second second, std::int64_t round_trips) {
+    std::int64_t count = 0;
+    stdexec::sync_wait(exec::repeat_effect_until(
+      stdexec::schedule(first) | stdexec::transfer(second)
+      | stdexec::then([&count, round_trips] { return ++count >= round_trips; })));
+  }
+
+  template <stdexec::scheduler Scheduler>
+  void fork_join(Scheduler sch, std::int64_t shape, std::vector<std::int64_t>& data) {
+    std::int64_t* out = data.data();
+    stdexec::sync_wait(
+      stdexec::schedule(sch) | stdexec::bulk(shape, [out](std::int64_t i) { out[i] += i; }));
+  }
+
+  template <stdexec::scheduler Scheduler>
+  std::int64_t spawn_storm(Scheduler sch, exec::async_scope& scope, std::int64_t tasks) {
+    std::atomic<std::int64_t> completed{0};
+    auto leaf = [&completed] {
+      completed.fetch_add(1, std::memory_order_relaxed);
+    };
+    for (std::int64_t i = 0; i < tasks; ++i) {
+      scope.spawn(stdexec::schedule(sch) | stdexec::then([&scope, sch, leaf] {
+                    leaf();
+                    scope.spawn(stdexec::schedule(sch) | stdexec::then(leaf));
+                  }));
+    }
+    stdexec::sync_wait(scope.on_empty());
+    return completed.load();
+  }
+
+  // Constructs a Context for a benchmark, or skips the benchmark if it cannot be constructed
+  // here, as when the kernel does not support io_uring.
+  template <class Context>
+  bool try_emplace(std::optional<Context>& context, bench::state& state) {
+    try {
+      context.emplace();
+      return true;
+    } catch (const std::system_error&) {
+      state.skip("the execution context is not available");
+      return false;
+    }
+  }
+
+  template <class Context>
+  void skynet_benchmark(bench::state& state) {
+    constexpr int depth = 5;
+    std::optional<Context> context;
+    if (!try_emplace(context, state)) {
+      return;
+    }
+    state.start();
+    std::int64_t sum = 0;
+    for (std::int64_t i = 0; i < state.iterations; ++i) {
+      sum = skynet<depth>(context->get_scheduler());
+    }
+    state.stop();
+    const std::int64_t leaves = skynet_tasks(depth) - skynet_tasks(depth - 1);
+    if (sum != leaves * (leaves - 1) / 2) {
+      state.fail("skynet computed the wrong sum");
+    }
+    state.items = state.iterations * skynet_tasks(depth);
+  }
+
+  template <class Context>
+  void ping_pong_benchmark(bench::state& state) {
+    std::optional<Context> first;
+    std::optional<Context> second;
+    if (!try_emplace(first, state) || !try_emplace(second, state)) {
+      return;
+    }
+    state.start();
+    ping_pong(first->get_scheduler(), second->get_scheduler(), state.iterations);
+    state.stop();
+  }
+
+  template <class Context>
+  void fork_join_benchmark(bench::state& state) {
+    std::optional<Context> context;
+    if (!try_emplace(context, state)) {
+      return;
+    }
+    std::vector<std::int64_t> data(static_cast<std::size_t>(state.arg));
+    state.start();
+    for (std::int64_t i = 0; i < state.iterations; ++i) {
+      fork_join(context->get_scheduler(), state.arg, data);
+    }
+    state.stop();
+    state.items = state.iterations * state.arg;
+  }
+
+  template <class Context>
+  void spawn_storm_benchmark(bench::state& state) {
+    std::optional<Context> context;
+    if (!try_emplace(context, state)) {
+      return;
+    }
+    exec::async_scope scope;
+    state.start();
+    state.items = spawn_storm(context->get_scheduler(), scope, state.iterations);
+    state.stop();
+  }
+
+  template <class Context>
+  void register_stress_workloads(const std::string& context_name) {
+    auto add = [&](const char* workload, function_t function, std::optional<std::int64_t> arg) {
+      std::string name = std::string("stress_") + workload + "/" + context_name;
+      if (arg) {
+        name += "/" + std::to_string(*arg);
+      }
+      registry().push_back({std::move(name), function, arg});
+    };
+    add("skynet", &skynet_benchmark<Context>, std::nullopt);
+    add("ping_pong", &ping_pong_benchmark<Context>, std::nullopt);
+    for (std::int64_t shape: {1, 64, 4096, 262144}) {
+      add("fork_join", &fork_join_benchmark<Context>, shape);
+    }
+    add("spawn_storm", &spawn_storm_benchmark<Context>, std::nullopt);
+  }
+} // namespace bench::stress
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// The cost of exec::task calls, per call.
+//
+// task_await_task is a linear chain of tasks, each awaiting the next, which resumes the child
+// by symmetric transfer. task_await_sender wraps the child in a sender adaptor, which forces
+// the general sender path; that path nests on the stack, so it runs with shallower chains.
+//
+// task_frame_cache and task_frame_heap are binary trees of tasks whose coroutine frames come
+// from the per-thread frame cache (the default) and straight from the global heap.
+
+#include "benchmark.hpp"
+
+#if !STDEXEC_STD_NO_COROUTINES_ && !STDEXEC_NVHPC()
+#include <exec/task.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+using namespace stdexec;
+
+namespace {
+  exec::task<std::int64_t> direct_chain(std::int64_t depth) {
+    if (depth == 0) {
+      co_return 0;
+    }
+    co_return 1 + co_await direct_chain(depth - 1);
+  }
+
+  exec::task<std::int64_t> sender_chain(std::int64_t depth) {
+    if (depth == 0) {
+      co_return 0;
+    }
+    co_return 1 + co_await (sender_chain(depth - 1) | then([](std::int64_t n) { return n; }));
+  }
+
+  // Frames come from the per-thread frame cache.
+  exec::task<std::int64_t> cached_tree(std::int64_t depth) {
+    if (depth == 0) {
+      co_return 1;
+    }
+    std::int64_t left = co_await cached_tree(depth - 1);
+    std::int64_t right = co_await cached_tree(depth - 1);
+    co_return left + right;
+  }
+
+  // Frames come from std::allocator, i.e. from the global heap on every call.
+  exec::task<std::int64_t>
+    heap_tree(std::allocator_arg_t, std::allocator<std::byte> alloc, std::int64_t depth) {
+    if (depth == 0) {
+      co_return 1;
+    }
+    std::int64_t left = co_await heap_tree(std::allocator_arg, alloc, depth - 1);
+    std::int64_t right = co_await heap_tree(std::allocator_arg, alloc, depth - 1);
+    co_return left + right;
+  }
+
+  template <class Fn>
+  void count_calls(bench::state& state, Fn fn) {
+    std::int64_t calls = 0;
+    for (std::int64_t i = 0; i < state.iterations; ++i) {
+      auto [n] = sync_wait(fn(state.arg)).value();
+      calls += n;
+    }
+    state.items = calls;
+  }
+
+  void task_await_task(bench::state& state) {
+    count_calls(state, [](std::int64_t depth) { return direct_chain(depth); });
+  }
+
+  STDEXEC_BENCHMARK(task_await_task, 16, 1024, 65536, 1'000'000);
+
+  void task_await_sender(bench::state& state) {
+    count_calls(state, [](std::int64_t depth) { return sender_chain(depth); });
+  }
+
+  STDEXEC_BENCHMARK(task_await_sender, 16, 1024);
+
+  void task_frame_cache(bench::state& state) {
+    count_calls(state, [](std::int64_t depth) { return cached_tree(depth); });
+  }
+
+  STDEXEC_BENCHMARK(task_frame_cache, 12);
+
+  void task_frame_heap(bench::state& state) {
+    count_calls(state, [](std::int64_t depth) {
+      return heap_tree(std::allocator_arg, std::allocator<std::byte>{}, depth);
+    });
+  }
+
+  STDEXEC_BENCHMARK(task_frame_heap, 12);
+} // namespace
+#endif
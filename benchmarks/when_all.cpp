@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// The cost of when_all by fan-out width, per when_all, with children that complete inline
+// and with children that each hop onto a thread pool.
+
+#include "benchmark.hpp"
+
+#include <exec/static_thread_pool.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+using namespace stdexec;
+
+namespace {
+  // Calls fn.template operator()<Width>() for the width in state.arg.
+  template <class Fn>
+  void with_width(bench::state& state, Fn fn) {
+    switch (state.arg) {
+    case 1:
+      return fn.template operator()<1>();
+    case 2:
+      return fn.template operator()<2>();
+    case 4:
+      return fn.template operator()<4>();
+    case 8:
+      return fn.template operator()<8>();
+    case 16:
+      return fn.template operator()<16>();
+    default:
+      state.skip("unsupported width");
+    }
+  }
+
+  template <class MakeChild, std::size_t... Is>
+  auto fan_out(MakeChild make_child, std::index_sequence<Is...>) {
+    return when_all(make_child(Is)...);
+  }
+
+  void when_all_just(bench::state& state) {
+    with_width(state, [&]<std::size_t Width>() {
+      for (std::int64_t i = 0; i < state.iterations; ++i) {
+        auto just_index = [](std::size_t index) {
+          return just(index);
+        };
+        sync_wait(fan_out(just_index, std::make_index_sequence<Width>{}));
+      }
+    });
+  }
+
+  STDEXEC_BENCHMARK(when_all_just, 1, 2, 4, 8, 16);
+
+  void when_all_static_thread_pool(bench::state& state) {
+    exec::static_thread_pool pool{4};
+    auto sch = pool.get_scheduler();
+    state.start();
+    with_width(state, [&]<std::size_t Width>() {
+      for (std::int64_t i = 0; i < state.iterations; ++i) {
+        auto schedule_on_pool = [&](std::size_t) {
+          return schedule(sch);
+        };
+        sync_wait(fan_out(schedule_on_pool, std::make_index_sequence<Width>{}));
+      }
+    });
+    state.stop();
+  }
+
+  STDEXEC_BENCHMARK(when_all_static_thread_pool, 1, 2, 4, 8, 16);
+} // namespace
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "../../stdexec/execution.hpp"
+
+namespace exec::__bulk_chunked {
+  using namespace stdexec;
+
+  // The function of a bulk_chunked, adapted to bulk's per-index convention. A scheduler
+  // that knows about it, like static_thread_pool, can call __fn_ with a whole index range
+  // instead.
+  template <class _Fun>
+  struct __range_fn {
+    _Fun __fn_;
+
+    template <integral _Shape, class... _As>
+      requires __callable<_Fun&, _Shape, _Shape, _As&...>
+    void operator()(_Shape __i, _As&... __as) //
+      noexcept(__nothrow_callable<_Fun&, _Shape, _Shape, _As&...>) {
+      __fn_(__i, static_cast<_Shape>(__i + 1), __as...);
+    }
+  };
+
+  template <class _Fun>
+  inline constexpr bool __is_range_fn = false;
+
+  template <class _Fun>
+  inline constexpr bool __is_range_fn<__range_fn<_Fun>> = true;
+} // namespace exec::__bulk_chunked
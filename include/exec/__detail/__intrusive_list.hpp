@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "../../stdexec/__detail/__config.hpp"
+
+#include <utility>
+
+namespace exec {
+  // A doubly linked __intrusive_queue, for waiters that a stop request must be able to
+  // remove from the middle in constant time.
+  template <auto _PrevPtr, auto _NextPtr>
+  class __intrusive_list;
+
+  template <class _Tp, _Tp* _Tp::*_PrevPtr, _Tp* _Tp::*_NextPtr>
+  class __intrusive_list<_PrevPtr, _NextPtr> {
+   public:
+    __intrusive_list() noexcept = default;
+
+    __intrusive_list(__intrusive_list&& __other) noexcept
+      : __head_(std::exchange(__other.__head_, nullptr))
+      , __tail_(std::exchange(__other.__tail_, nullptr)) {
+    }
+
+    __intrusive_list& operator=(__intrusive_list __other) noexcept {
+      std::swap(__head_, __other.__head_);
+      std::swap(__tail_, __other.__tail_);
+      return *this;
+    }
+
+    ~__intrusive_list() {
+      STDEXEC_ASSERT(empty());
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+      return __head_ == nullptr;
+    }
+
+    [[nodiscard]] _Tp* front() const noexcept {
+      return __head_;
+    }
+
+    void push_back(_Tp* __item) noexcept {
+      STDEXEC_ASSERT(__item != nullptr);
+      __item->*_PrevPtr = __tail_;
+      __item->*_NextPtr = nullptr;
+      (__tail_ ? __tail_->*_NextPtr : __head_) = __item;
+      __tail_ = __item;
+    }
+
+    [[nodiscard]] _Tp* pop_front() noexcept {
+      STDEXEC_ASSERT(!empty());
+      _Tp* __item = __head_;
+      erase(__item);
+      return __item;
+    }
+
+    // The item must be in this list.
+    void erase(_Tp* __item) noexcept {
+      (__item->*_PrevPtr ? __item->*_PrevPtr->*_NextPtr : __head_) = __item->*_NextPtr;
+      (__item->*_NextPtr ? __item->*_NextPtr->*_PrevPtr : __tail_) = __item->*_PrevPtr;
+      __item->*_PrevPtr = nullptr;
+      __item->*_NextPtr = nullptr;
+    }
+
+   private:
+    _Tp* __head_ = nullptr;
+    _Tp* __tail_ = nullptr;
+  };
+}
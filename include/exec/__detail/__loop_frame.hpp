@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <utility>
+
+namespace exec {
+
+  // Lets an operation that runs a loop of child operations handle children that complete
+  // synchronously from within start() without nesting on the stack.
+  //
+  // The loop of an operation keeps a __loop_frame on the stack while it starts a child. The
+  // frames of the loops running on a thread form a chain, innermost first. When a child
+  // completes and the operation wants another iteration, it calls __loop_frame::__resume.
+  // If a loop of the operation is on the chain, even below the loops of other operations
+  // that the child runs, that loop is told to run the next iteration once the stack unwinds
+  // back to it. Otherwise the completion came from elsewhere and the operation has to start
+  // a new loop.
+  //
+  //   void __loop() noexcept {
+  //     __loop_frame __frame{this};
+  //     do {
+  //       ... start the next child ...
+  //     } while (__frame.__again());
+  //   }
+  //
+  //   void __next() noexcept {
+  //     if (!__loop_frame::__resume(this)) {
+  //       __loop();
+  //     }
+  //   }
+  //
+  // A loop must not touch its operation after starting a child unless __again() returned
+  // true, because a child that completes may destroy the operation.
+  class __loop_frame {
+    static inline thread_local __loop_frame* __current_ = nullptr;
+
+    const void* __op_;
+    __loop_frame* __prev_;
+    bool __again_ = false;
+
+   public:
+    explicit __loop_frame(const void* __op) noexcept
+      : __op_{__op}
+      , __prev_{std::exchange(__current_, this)} {
+    }
+
+    __loop_frame(__loop_frame&&) = delete;
+
+    ~__loop_frame() {
+      __current_ = __prev_;
+    }
+
+    // Returns true, and resets the request, if another iteration was asked for.
+    bool __again() noexcept {
+      return std::exchange(__again_, false);
+    }
+
+    // Returns true if a loop of __op is running on this thread and will run the next
+    // iteration.
+    static bool __resume(const void* __op) noexcept {
+      for (__loop_frame* __frame = __current_; __frame != nullptr; __frame = __frame->__prev_) {
+        if (__frame->__op_ == __op) {
+          __frame->__again_ = true;
+          return true;
+        }
+      }
+      return false;
+    }
+  };
+
+} // namespace exec
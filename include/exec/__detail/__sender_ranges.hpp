@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "../../stdexec/execution.hpp"
+
+#include "__manual_lifetime.hpp"
+
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <vector>
+
+// Utilities shared by the algorithms that operate on a runtime-sized range of
+// senders of the same type, like when_all_range and when_first_k.
+namespace exec::__sender_ranges {
+  using namespace stdexec;
+
+  template <class _Range>
+  concept __range_of_senders =
+    std::ranges::random_access_range<_Range> && std::ranges::sized_range<_Range>
+    && sender<std::ranges::range_value_t<_Range>>;
+
+  // The children are moved out of the range held by the operation state.
+  template <class _Range>
+  using __child_sender_t = std::ranges::range_rvalue_reference_t<_Range>;
+
+  // set_value_t() collects nothing, set_value_t(T) collects T, and
+  // set_value_t(Ts...) collects std::tuple<Ts...>.
+  template <class... _As>
+  struct __element {
+    using __t = __decayed_tuple<_As...>;
+  };
+
+  template <class _Ay>
+  struct __element<_Ay> {
+    using __t = __decay_t<_Ay>;
+  };
+
+  template <>
+  struct __element<> {
+    using __t = void;
+  };
+
+  template <class... _As>
+  using __element_t = stdexec::__t<__element<_As...>>;
+
+  template <class... _Elements>
+    requires(sizeof...(_Elements) <= 1)
+  using __single_or_void = __mfront<_Elements..., void>;
+
+  template <class _Sender, class _Env>
+  using __element_of_t =
+    __value_types_of_t<_Sender, _Env, __q<__element_t>, __q<__single_or_void>>;
+
+  template <class _Element>
+  using __set_value_sig_t =
+    __if_c<same_as<_Element, void>, set_value_t(), set_value_t(std::vector<_Element>)>;
+
+  // Values are assigned in place when the element type allows it; otherwise
+  // they are staged in optionals and moved into the result at the end.
+  template <class _Element>
+  inline constexpr bool __assignable_in_place =
+    std::default_initializable<_Element> && std::is_move_assignable_v<_Element>;
+
+  template <class _Element>
+  using __values_t = __if_c<
+    same_as<_Element, void>,
+    __ignore,
+    __if_c<
+      __assignable_in_place<_Element>,
+      std::vector<_Element>,
+      std::vector<std::optional<_Element>>>>;
+
+  template <class _Element, class... _Values>
+  void __store_value(__values_t<_Element>& __values, std::size_t __index, _Values&&... __vals) {
+    if constexpr (__assignable_in_place<_Element>) {
+      __values[__index] = _Element((_Values&&) __vals...);
+    } else {
+      __values[__index].emplace((_Values&&) __vals...);
+    }
+  }
+
+  template <class _Element>
+  std::vector<_Element> __take_values(__values_t<_Element>& __values, std::size_t __count) {
+    if constexpr (__assignable_in_place<_Element>) {
+      __values.resize(__count);
+      return std::move(__values);
+    } else {
+      std::vector<_Element> __result;
+      __result.reserve(__count);
+      for (std::size_t __i = 0; __i < __count; ++__i) {
+        __result.push_back(std::move(*__values[__i]));
+      }
+      return __result;
+    }
+  }
+
+  template <class _Env>
+  auto __get_allocator(const _Env& __env) noexcept {
+    if constexpr (__callable<get_allocator_t, const _Env&>) {
+      return get_allocator(__env);
+    } else {
+      return std::allocator<char>{};
+    }
+  }
+
+  template <class _Env, class _Ty>
+  using __allocator_for_t = typename std::allocator_traits<decltype(__get_allocator(
+    __declval<const _Env&>()))>::template rebind_alloc<_Ty>;
+
+  // A runtime number of operation states in one allocation. They are all
+  // connected up front and destroyed together.
+  template <class _Op, class _Allocator>
+  class __op_array {
+    using __slot_t = __manual_lifetime<_Op>;
+    using __allocator_t =
+      typename std::allocator_traits<_Allocator>::template rebind_alloc<__slot_t>;
+    using __traits_t = std::allocator_traits<__allocator_t>;
+
+   public:
+    // __connect(__i) returns the __i-th operation state.
+    template <class _ConnectFn>
+    __op_array(const _Allocator& __alloc, std::size_t __size, _ConnectFn __connect)
+      : __alloc_(__alloc)
+      , __size_(__size) {
+      if (__size_ == 0) {
+        return;
+      }
+      __slots_ = __traits_t::allocate(__alloc_, __size_);
+      std::size_t __i = 0;
+      try {
+        for (; __i < __size_; ++__i) {
+          __traits_t::construct(__alloc_, __slots_ + __i);
+          __slots_[__i].__construct_with([&] { return __connect(__i); });
+        }
+      } catch (...) {
+        __traits_t::destroy(__alloc_, __slots_ + __i);
+        __destroy_n(__i);
+        throw;
+      }
+    }
+
+    __op_array(__op_array&&) = delete;
+
+    ~__op_array() {
+      __destroy_n(__size_);
+    }
+
+    _Op& operator[](std::size_t __i) noexcept {
+      return __slots_[__i].__get();
+    }
+
+    std::size_t size() const noexcept {
+      return __size_;
+    }
+
+   private:
+    void __destroy_n(std::size_t __n) noexcept {
+      for (std::size_t __i = 0; __i < __n; ++__i) {
+        __slots_[__i].__destruct();
+        __traits_t::destroy(__alloc_, __slots_ + __i);
+      }
+      if (__slots_ != nullptr) {
+        __traits_t::deallocate(__alloc_, __slots_, __size_);
+      }
+    }
+
+    STDEXEC_NO_UNIQUE_ADDRESS __allocator_t __alloc_;
+    std::size_t __size_;
+    __slot_t* __slots_{nullptr};
+  };
+} // namespace exec::__sender_ranges
@@ -18,8 +18,26 @@
 #include <stdexec/execution.hpp>
 
 #include <cstddef>
+#include <new>
 
 namespace exec {
+  // Configures the inline buffers of a type-erased sender: the sender itself is stored inline if
+  // it fits in _InlineSize bytes aligned to _Alignment, and the operation state produced by
+  // connect is stored inline if it fits in _OperationInlineSize bytes aligned to
+  // _OperationAlignment. Otherwise the sender is heap-allocated and the operation state is
+  // allocated with the receiver's allocator.
+  template <
+    std::size_t _InlineSize = 3 * sizeof(void*),
+    std::size_t _Alignment = alignof(std::max_align_t),
+    std::size_t _OperationInlineSize = 3 * sizeof(void*),
+    std::size_t _OperationAlignment = alignof(std::max_align_t)>
+  struct any_sender_storage {
+    static constexpr std::size_t inline_size = _InlineSize;
+    static constexpr std::size_t alignment = _Alignment;
+    static constexpr std::size_t operation_inline_size = _OperationInlineSize;
+    static constexpr std::size_t operation_alignment = _OperationAlignment;
+  };
+
   namespace __any {
     using namespace stdexec;
 
@@ -544,7 +562,136 @@ namespace exec {
       }
     };
 
-    using __unique_operation_storage = __unique_storage_t<__operation_vtable>;
+    template <class _Env>
+    auto __get_allocator(const _Env& __env) noexcept {
+      if constexpr (__callable<get_allocator_t, const _Env&>) {
+        return get_allocator(__env);
+      } else {
+        return std::allocator<std::byte>{};
+      }
+    }
+
+    template <class _Receiver>
+    using __receiver_allocator_t =
+      decltype(__any::__get_allocator(get_env(__declval<_Receiver&>())));
+
+    // A type-erased reference to the receiver's allocator. Over-aligned requests bypass the
+    // allocator, since it can only be rebound to types known at compile time.
+    class __allocator_ref {
+     public:
+      template <__not_decays_to<__allocator_ref> _Allocator>
+      explicit __allocator_ref(_Allocator& __alloc) noexcept
+        : __alloc_{&__alloc}
+        , __allocate_{[](void* __alloc, std::size_t __size) -> void* {
+          using _Alloc = typename std::allocator_traits<_Allocator>::template rebind_alloc<__block>;
+          static_assert(std::is_pointer_v<typename std::allocator_traits<_Alloc>::pointer>);
+          _Alloc __block_alloc{*static_cast<_Allocator*>(__alloc)};
+          return std::allocator_traits<_Alloc>::allocate(__block_alloc, __blocks(__size));
+        }}
+        , __deallocate_{[](void* __alloc, void* __pointer, std::size_t __size) noexcept {
+          using _Alloc = typename std::allocator_traits<_Allocator>::template rebind_alloc<__block>;
+          _Alloc __block_alloc{*static_cast<_Allocator*>(__alloc)};
+          std::allocator_traits<_Alloc>::deallocate(
+            __block_alloc, static_cast<__block*>(__pointer), __blocks(__size));
+        }} {
+      }
+
+      void* __allocate(std::size_t __size, std::size_t __align) {
+        if (__align > alignof(__block)) {
+          return ::operator new(__size, std::align_val_t{__align});
+        }
+        return __allocate_(__alloc_, __size);
+      }
+
+      void __deallocate(void* __pointer, std::size_t __size, std::size_t __align) noexcept {
+        if (__align > alignof(__block)) {
+          ::operator delete(__pointer, __size, std::align_val_t{__align});
+        } else {
+          __deallocate_(__alloc_, __pointer, __size);
+        }
+      }
+
+     private:
+      using __block = std::max_align_t;
+
+      static constexpr std::size_t __blocks(std::size_t __size) noexcept {
+        return (__size + sizeof(__block) - 1) / sizeof(__block);
+      }
+
+      void* __alloc_;
+      void* (*__allocate_)(void*, std::size_t);
+      void (*__deallocate_)(void*, void*, std::size_t) noexcept;
+    };
+
+    // Holds a type-erased operation state. Unlike __storage, it is immovable, so any operation
+    // state that fits in the inline buffer is constructed there in place.
+    template <std::size_t _InlineSize, std::size_t _Alignment>
+    struct __operation_storage {
+      class __t;
+    };
+
+    template <std::size_t _InlineSize, std::size_t _Alignment>
+    class __operation_storage<_InlineSize, _Alignment>::__t : __immovable {
+      static constexpr std::size_t __buffer_size = std::max(_InlineSize, sizeof(void*));
+      static constexpr std::size_t __alignment = std::max(_Alignment, alignof(void*));
+      using __with_delete = __delete_t(void() noexcept);
+      using __vtable_t = __storage_vtable<__operation_vtable, __with_delete>;
+
+      template <class _Op>
+      static constexpr bool __is_small = sizeof(_Op) <= __buffer_size
+                                      && alignof(_Op) <= __alignment;
+
+     public:
+      using __id = __operation_storage;
+
+      explicit __t(__allocator_ref __alloc) noexcept
+        : __alloc_{__alloc} {
+      }
+
+      ~__t() {
+        (*__vtable_)(__delete, this);
+      }
+
+      template <class _Op, class... _As>
+      void __emplace(_As&&... __as) {
+        STDEXEC_ASSERT(__object_pointer_ == nullptr);
+        if constexpr (__is_small<_Op>) {
+          __object_pointer_ = ::new (static_cast<void*>(__buffer_)) _Op((_As&&) __as...);
+        } else {
+          void* __pointer = __alloc_.__allocate(sizeof(_Op), alignof(_Op));
+          try {
+            __object_pointer_ = ::new (__pointer) _Op((_As&&) __as...);
+          } catch (...) {
+            __alloc_.__deallocate(__pointer, sizeof(_Op), alignof(_Op));
+            throw;
+          }
+        }
+        __vtable_ = &__storage_vtbl<__t, _Op, __operation_vtable, __with_delete>;
+      }
+
+      void __start() noexcept {
+        STDEXEC_ASSERT(__vtable_->__start_);
+        __vtable_->__start_(__object_pointer_);
+      }
+
+     private:
+      template <class _Op>
+      friend void tag_invoke(__delete_t, __mtype<_Op>, __t& __self) noexcept {
+        if (!__self.__object_pointer_) {
+          return;
+        }
+        _Op* __op = static_cast<_Op*>(std::exchange(__self.__object_pointer_, nullptr));
+        __op->~_Op();
+        if constexpr (!__is_small<_Op>) {
+          __self.__alloc_.__deallocate(__op, sizeof(_Op), alignof(_Op));
+        }
+      }
+
+      const __vtable_t* __vtable_{__default_storage_vtable((__vtable_t*) nullptr)};
+      void* __object_pointer_{nullptr};
+      __allocator_ref __alloc_;
+      alignas(__alignment) std::byte __buffer_[__buffer_size];
+    };
 
     template <class _Sigs, class _Queries>
     using __receiver_ref = __mapply<__mbind_front<__q<__rec::__ref>, _Sigs>, _Queries>;
@@ -582,16 +729,18 @@ namespace exec {
 
         __t(_Sender&& __sender, _Receiver&& __receiver)
           : __operation_base<_Receiver, _Sigs, _Queries>{(_Receiver&&) __receiver}
-          , __storage_{__sender.__connect(__receiver_ref_t{__rec_})} {
+          , __alloc_{__any::__get_allocator(get_env(this->__receiver_))}
+          , __storage_{__allocator_ref{__alloc_}} {
+          __sender.__connect(__storage_, __receiver_ref_t{__rec_});
         }
 
        private:
         __rec __rec_{static_cast<__operation_base<_Receiver, _Sigs, _Queries>*>(this)};
-        __unique_operation_storage __storage_{};
+        STDEXEC_NO_UNIQUE_ADDRESS __receiver_allocator_t<_Receiver> __alloc_;
+        typename _Sender::__operation_storage_t __storage_;
 
         friend void tag_invoke(start_t, __t& __self) noexcept {
-          STDEXEC_ASSERT(__self.__storage_.__get_vtable()->__start_);
-          __self.__storage_.__get_vtable()->__start_(__self.__storage_.__get_object_pointer());
+          __self.__storage_.__start();
         }
       };
     };
@@ -614,9 +763,15 @@ namespace exec {
       }
     };
 
-    template <class _Sigs, class _SenderQueries = __types<>, class _ReceiverQueries = __types<>>
+    template <
+      class _Sigs,
+      class _SenderQueries = __types<>,
+      class _ReceiverQueries = __types<>,
+      class _Storage = any_sender_storage<>>
     struct __sender {
       using __receiver_ref_t = __receiver_ref<_Sigs, _ReceiverQueries>;
+      using __operation_storage_t = stdexec::__t<
+        __operation_storage<_Storage::operation_inline_size, _Storage::operation_alignment>>;
 
       class __vtable : public __query_vtable<_SenderQueries> {
        public:
@@ -626,20 +781,22 @@ namespace exec {
           return *this;
         }
 
-        __unique_operation_storage (*__connect_)(void*, __receiver_ref_t);
+        void (*__connect_)(void*, __operation_storage_t&, __receiver_ref_t);
        private:
         template <sender_to<__receiver_ref_t> _Sender>
         friend const __vtable*
           tag_invoke(__create_vtable_t, __mtype<__vtable>, __mtype<_Sender>) noexcept {
           static const __vtable __vtable_{
             {*__create_vtable(__mtype<__query_vtable<_SenderQueries>>{}, __mtype<_Sender>{})},
-            [](void* __object_pointer, __receiver_ref_t __receiver) -> __unique_operation_storage {
+            [](
+              void* __object_pointer,
+              __operation_storage_t& __storage,
+              __receiver_ref_t __receiver) {
               _Sender& __sender = *static_cast<_Sender*>(__object_pointer);
               using __op_state_t = connect_result_t<_Sender, __receiver_ref_t>;
-              return __unique_operation_storage{
-                std::in_place_type<__op_state_t>, __conv{[&] {
-                  return connect((_Sender&&) __sender, (__receiver_ref_t&&) __receiver);
-                }}};
+              __storage.template __emplace<__op_state_t>(__conv{[&] {
+                return connect((_Sender&&) __sender, (__receiver_ref_t&&) __receiver);
+              }});
             }};
           return &__vtable_;
         }
@@ -667,6 +824,7 @@ namespace exec {
       class __t {
        public:
         using __id = __sender;
+        using __operation_storage_t = __sender::__operation_storage_t;
         using completion_signatures = _Sigs;
         using is_sender = void;
 
@@ -682,9 +840,9 @@ namespace exec {
           : __storage_{(_Sender&&) __sndr} {
         }
 
-        __unique_operation_storage __connect(__receiver_ref_t __receiver) {
-          return __storage_.__get_vtable()->__connect_(
-            __storage_.__get_object_pointer(), (__receiver_ref_t&&) __receiver);
+        void __connect(__operation_storage_t& __op_storage, __receiver_ref_t __receiver) {
+          __storage_.__get_vtable()->__connect_(
+            __storage_.__get_object_pointer(), __op_storage, (__receiver_ref_t&&) __receiver);
         }
 
         explicit operator bool() const noexcept {
@@ -692,7 +850,14 @@ namespace exec {
         }
 
        private:
-        __unique_storage_t<__vtable> __storage_;
+        using __storage_t = __storage<
+          __vtable,
+          std::allocator<std::byte>,
+          false,
+          _Storage::alignment,
+          _Storage::inline_size>;
+
+        stdexec::__t<__storage_t> __storage_;
 
         template <receiver_of<_Sigs> _Rcvr>
         friend stdexec::__t<__operation<__t, __decay_t<_Rcvr>, _ReceiverQueries>>
@@ -812,13 +977,16 @@ namespace exec {
       : __receiver_(__receiver) {
     }
 
-    template <auto... _SenderQueries>
-    class any_sender {
-      using __sender_base = stdexec::__t<
-        __any::__sender<_Completions, queries<_SenderQueries...>, queries<_ReceiverQueries...>>>;
+    template <class _Storage, auto... _SenderQueries>
+    class basic_any_sender {
+      using __sender_base = stdexec::__t<__any::__sender<
+        _Completions,
+        queries<_SenderQueries...>,
+        queries<_ReceiverQueries...>,
+        _Storage>>;
       __sender_base __sender_;
 
-      template <class _Tag, stdexec::__decays_to<any_sender> Self, class... _As>
+      template <class _Tag, stdexec::__decays_to<basic_any_sender> Self, class... _As>
         requires stdexec::tag_invocable< _Tag, stdexec::__copy_cvref_t<Self, __sender_base>, _As...>
       friend auto tag_invoke(_Tag, Self&& __self, _As&&... __as) noexcept(
         std::is_nothrow_invocable_v< _Tag, stdexec::__copy_cvref_t<Self, __sender_base>, _As...>) {
@@ -829,8 +997,8 @@ namespace exec {
       using completion_signatures = typename __sender_base::completion_signatures;
 
       template <class _Sender>
-        requires(!stdexec::__decays_to<_Sender, any_sender>) && stdexec::sender<_Sender>
-      any_sender(_Sender&& __sender) noexcept(
+        requires(!stdexec::__decays_to<_Sender, basic_any_sender>) && stdexec::sender<_Sender>
+      basic_any_sender(_Sender&& __sender) noexcept(
         stdexec::__nothrow_constructible_from<__sender_base, _Sender>)
         : __sender_((_Sender&&) __sender) {
       }
@@ -893,5 +1061,8 @@ namespace exec {
           operator==(const any_scheduler& __self, const any_scheduler& __other) noexcept = default;
       };
     };
+
+    template <auto... _SenderQueries>
+    using any_sender = basic_any_sender<any_sender_storage<>, _SenderQueries...>;
   };
 } // namespace exec
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "async_semaphore.hpp"
+
+namespace exec {
+  /////////////////////////////////////////////////////////////////////////////
+  // async_mutex: a mutex whose lock() is a sender that completes once the
+  // mutex is held, so that a critical section can wait for it without
+  // blocking a thread. The operations waiting for the mutex acquire it in
+  // order; unlock() hands it to the oldest one, which resumes on the
+  // unlocking thread, or on the scheduler sch if it was started by lock(sch).
+  //
+  //   exec::async_mutex mutex;
+  //   co_await mutex.lock();
+  //   ++shared_counter;
+  //   mutex.unlock();
+  //
+  // A waiting lock operation completes with set_stopped if its receiver's
+  // stop token is triggered, and leaves the queue in constant time.
+  class async_mutex {
+   public:
+    async_mutex() noexcept = default;
+
+    [[nodiscard]] auto lock() noexcept {
+      return __semaphore_.acquire();
+    }
+
+    template <stdexec::scheduler _Scheduler>
+    [[nodiscard]] auto lock(_Scheduler&& __sched) {
+      return __semaphore_.acquire(1, (_Scheduler&&) __sched);
+    }
+
+    [[nodiscard]] bool try_lock() noexcept {
+      return __semaphore_.try_acquire();
+    }
+
+    void unlock() noexcept {
+      __semaphore_.release();
+    }
+
+   private:
+    async_semaphore __semaphore_{1};
+  };
+} // namespace exec
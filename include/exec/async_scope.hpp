@@ -19,6 +19,16 @@
 #include "../stdexec/__detail/__intrusive_queue.hpp"
 #include "env.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
 namespace exec {
   /////////////////////////////////////////////////////////////////////////////
   // async_scope
@@ -37,19 +47,352 @@ namespace exec {
     template <class _BaseEnv>
     using __env_t = make_env_t< _BaseEnv, with_t<get_stop_token_t, in_place_stop_token>>;
 
+    ////////////////////////////////////////////////////////////////////////////
+    // A leaf of a two-level scalable nonzero indicator (SNZI). Nested operations arrive at
+    // and depart from a shard chosen by their starting thread, and only a shard's
+    // transitions between zero and nonzero reach the scope's shared counter. The count is
+    // stored doubled so that the intermediate "one half" state of the SNZI algorithm is 1;
+    // the upper 32 bits hold a version that distinguishes successive 0 -> 1/2 transitions.
+    struct alignas(64) __shard {
+      static constexpr std::uint64_t __half = 1;
+      static constexpr std::uint64_t __one = 2;
+      static constexpr std::uint64_t __count_mask = 0xFFFFFFFFu;
+      static constexpr std::uint64_t __one_version = std::uint64_t{1} << 32;
+
+      std::atomic<std::uint64_t> __state_{0};
+
+      void __arrive(const __impl& __root) noexcept;
+      void __depart(const __impl* __root) noexcept;
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // The in-flight limit of a bounded_async_scope. A slot is taken by each nested operation
+    // from its start until its completion, or by the reservation that an acquire() operation
+    // completes with, until the reservation is consumed by a nested operation or destroyed.
+    // Operations waiting in acquire() form a doubly linked list so that a stop request can
+    // unlink one in constant time.
+    struct __acquire_waiter : __immovable {
+      void (*__complete_)(__acquire_waiter*) noexcept;
+      __acquire_waiter* __prev_ = nullptr;
+      __acquire_waiter* __next_ = nullptr;
+      bool __queued_ = false;
+    };
+
+    struct __bound {
+      std::mutex __lock_{};
+      const std::size_t __max_in_flight_;
+      std::size_t __in_flight_{0};
+      __acquire_waiter* __head_{nullptr};
+      __acquire_waiter* __tail_{nullptr};
+
+      explicit __bound(std::size_t __max_in_flight) noexcept
+        : __max_in_flight_{__max_in_flight} {
+      }
+
+      enum class __acquire_result {
+        __reserved,
+        __queued,
+        __stopped
+      };
+
+      // If no slot is free, the waiter is queued and its __complete_ function is called once a
+      // slot has been reserved for it. The stop token is checked under the lock, so a stop
+      // callback that ran before the waiter was queued cannot be missed.
+      template <class _StopToken>
+      __acquire_result
+        __reserve_or_enqueue(__acquire_waiter* __waiter, const _StopToken& __token) noexcept {
+        std::unique_lock __guard{__lock_};
+        if (__token.stop_requested()) {
+          return __acquire_result::__stopped;
+        }
+        if (__in_flight_ < __max_in_flight_) {
+          ++__in_flight_;
+          return __acquire_result::__reserved;
+        }
+        __waiter->__prev_ = __tail_;
+        __waiter->__next_ = nullptr;
+        (__tail_ ? __tail_->__next_ : __head_) = __waiter;
+        __tail_ = __waiter;
+        __waiter->__queued_ = true;
+        return __acquire_result::__queued;
+      }
+
+      // Returns true if the waiter was still queued, in which case it will not be granted a
+      // slot.
+      bool __remove(__acquire_waiter* __waiter) noexcept {
+        std::unique_lock __guard{__lock_};
+        if (!__waiter->__queued_) {
+          return false;
+        }
+        __unlink(__waiter);
+        return true;
+      }
+
+      // A nested operation that consumes a reservation takes over its slot.
+      void __on_nest_start(bool __reserved) noexcept {
+        if (!__reserved) {
+          std::unique_lock __guard{__lock_};
+          ++__in_flight_;
+        }
+      }
+
+      // Returns the waiter that was granted the freed slot, if any.
+      __acquire_waiter* __on_nest_complete() noexcept {
+        std::unique_lock __guard{__lock_};
+        --__in_flight_;
+        if (__head_ == nullptr || __in_flight_ >= __max_in_flight_) {
+          return nullptr;
+        }
+        __acquire_waiter* __waiter = __head_;
+        __unlink(__waiter);
+        ++__in_flight_;
+        return __waiter;
+      }
+
+      // Frees a slot that was reserved but not used.
+      void __release() noexcept {
+        if (__acquire_waiter* __waiter = __on_nest_complete()) {
+          __waiter->__complete_(__waiter);
+        }
+      }
+
+     private:
+      void __unlink(__acquire_waiter* __waiter) noexcept {
+        (__waiter->__prev_ ? __waiter->__prev_->__next_ : __head_) = __waiter->__next_;
+        (__waiter->__next_ ? __waiter->__next_->__prev_ : __tail_) = __waiter->__prev_;
+        __waiter->__queued_ = false;
+      }
+    };
+
+    // A slot of a bounded_async_scope reserved by acquire(). It is consumed by the nested
+    // operation it is passed to when that operation starts. If it is destroyed before, the
+    // slot is given back to the scope.
+    class __reservation {
+      __bound* __bound_ = nullptr;
+
+     public:
+      __reservation() = default;
+
+      explicit __reservation(__bound* __bound) noexcept
+        : __bound_{__bound} {
+      }
+
+      __reservation(__reservation&& __other) noexcept
+        : __bound_{std::exchange(__other.__bound_, nullptr)} {
+      }
+
+      __reservation& operator=(__reservation&& __other) noexcept {
+        if (this != &__other) {
+          release();
+          __bound_ = std::exchange(__other.__bound_, nullptr);
+        }
+        return *this;
+      }
+
+      ~__reservation() {
+        release();
+      }
+
+      // Returns true if the reservation still holds a slot.
+      explicit operator bool() const noexcept {
+        return __bound_ != nullptr;
+      }
+
+      // Gives the slot back to the scope.
+      void release() noexcept {
+        if (__bound* __bound = std::exchange(__bound_, nullptr)) {
+          __bound->__release();
+        }
+      }
+
+      // Hands the slot over to a starting nested operation. Returns true if there was one.
+      bool __consume() noexcept {
+        return std::exchange(__bound_, nullptr) != nullptr;
+      }
+    };
+
+    // The reservation of a nested operation that was not given one.
+    struct __no_reservation {
+      static constexpr bool __consume() noexcept {
+        return false;
+      }
+    };
+
     struct __impl {
+      // __state_ packs the number of active nested operations (in the upper bits) with a flag
+      // (the low bit) that is set while when_empty waiters may be queued. __lock_ guards only
+      // __waiters_, so starting and completing a nested operation is a single atomic
+      // read-modify-write unless somebody is waiting for the scope to become empty.
+      static constexpr std::size_t __has_waiters = 1;
+      static constexpr std::size_t __one_active = 2;
+
       in_place_stop_source __stop_source_{};
+      mutable std::atomic<std::size_t> __state_{0};
       mutable std::mutex __lock_{};
-      mutable std::ptrdiff_t __active_ = 0;
       mutable __intrusive_queue<&__task::__next_> __waiters_{};
+      // Only set for a sharded_async_scope. The number of shards is a power of two.
+      std::unique_ptr<__shard[]> __shards_{};
+      std::size_t __shard_mask_{0};
+      // Only set for a bounded_async_scope.
+      std::unique_ptr<__bound> __bound_{};
+
+      __impl() = default;
+
+      // A __shard_count or __max_in_flight of zero turns sharding or the limit off.
+      __impl(std::size_t __shard_count, std::size_t __max_in_flight) {
+        if (__shard_count != 0) {
+          __shard_mask_ = std::bit_ceil(__shard_count) - 1;
+          __shards_ = std::make_unique<__shard[]>(__shard_mask_ + 1);
+        }
+        if (__max_in_flight != 0) {
+          __bound_ = std::make_unique<__bound>(__max_in_flight);
+        }
+      }
 
       ~__impl() {
         std::unique_lock __guard{__lock_};
-        STDEXEC_ASSERT(__active_ == 0);
+        STDEXEC_ASSERT(__state_.load(std::memory_order_relaxed) == 0);
         STDEXEC_ASSERT(__waiters_.empty());
       }
+
+      void __add_active() const noexcept {
+        __state_.fetch_add(__one_active, std::memory_order_relaxed);
+      }
+
+      // Returns the shard the operation arrived at, or nullptr if the scope is not sharded.
+      __shard* __arrive(bool __reserved = false) const noexcept {
+        if (__bound_) {
+          __bound_->__on_nest_start(__reserved);
+        }
+        if (!__shards_) {
+          __add_active();
+          return nullptr;
+        }
+        __shard* __s = &__shards_[__this_thread_index() & __shard_mask_];
+        __s->__arrive(*this);
+        return __s;
+      }
+
+      static void __depart(const __impl* __scope, __shard* __s) noexcept {
+        if (__scope->__bound_) {
+          // The departing operation is still counted, so the scope stays alive while the
+          // waiter that takes over its slot is completed.
+          if (__acquire_waiter* __waiter = __scope->__bound_->__on_nest_complete()) {
+            __waiter->__complete_(__waiter);
+          }
+        }
+        if (__s) {
+          __s->__depart(__scope);
+        } else {
+          __remove_active(__scope);
+        }
+      }
+
+      static std::size_t __this_thread_index() noexcept {
+        static std::atomic<std::size_t> __next_index{0};
+        thread_local const std::size_t __index =
+          __next_index.fetch_add(1, std::memory_order_relaxed);
+        return __index;
+      }
+
+      // Returns false if the scope is empty, in which case the waiter should proceed
+      // immediately. Otherwise the waiter is queued and will be notified once the last active
+      // operation completes.
+      bool __enqueue_waiter(__task* __waiter) const noexcept {
+        std::unique_lock __guard{__lock_};
+        // Set the flag and read the count in one step, so that any completion that brings the
+        // count to zero after this point sees the flag.
+        std::size_t __old = __state_.fetch_or(__has_waiters, std::memory_order_acq_rel);
+        if (__old >= __one_active) {
+          __waiters_.push_back(__waiter);
+          return true;
+        }
+        __state_.fetch_and(~__has_waiters, std::memory_order_relaxed);
+        return false;
+      }
+
+      static void __remove_active(const __impl* __scope) noexcept {
+        std::size_t __old = __scope->__state_.load(std::memory_order_relaxed);
+        do {
+          if (__old == (__one_active | __has_waiters)) {
+            // The last active operation is completing and there are waiters. Stay counted
+            // until the lock is held, so no waiter can run and destroy the scope under us.
+            __notify_waiters(__scope);
+            return;
+          }
+        } while (!__scope->__state_.compare_exchange_weak(
+          __old, __old - __one_active, std::memory_order_acq_rel, std::memory_order_relaxed));
+        // do not access __scope
+      }
+
+      static void __notify_waiters(const __impl* __scope) noexcept {
+        std::unique_lock __guard{__scope->__lock_};
+        std::size_t __old = __scope->__state_.fetch_sub(__one_active, std::memory_order_acq_rel);
+        if (__old != (__one_active | __has_waiters)) {
+          // Another operation was started in the meantime. Its completion will notify the
+          // waiters.
+          return;
+        }
+        auto __local = std::move(__scope->__waiters_);
+        __scope->__state_.fetch_and(~__has_waiters, std::memory_order_relaxed);
+        __guard.unlock();
+        __scope = nullptr;
+        // do not access __scope
+        while (!__local.empty()) {
+          auto* __next = __local.pop_front();
+          __next->__notify_waiter(__next);
+          // __scope must be considered deleted
+        }
+      }
     };
 
+    inline void __shard::__arrive(const __impl& __root) noexcept {
+      std::size_t __undo_arrivals = 0;
+      std::uint64_t __old = __state_.load(std::memory_order_relaxed);
+      while (true) {
+        const std::uint64_t __count = __old & __count_mask;
+        if (__count >= __one) {
+          if (__state_.compare_exchange_weak(
+                __old, __old + __one, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            break;
+          }
+        } else if (__count == 0) {
+          const std::uint64_t __half_state = (__old & ~__count_mask) + __one_version + __half;
+          if (__state_.compare_exchange_weak(
+                __old, __half_state, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            __old = __half_state;
+          }
+        } else {
+          // Somebody (perhaps this thread) moved the shard to 1/2. Help it arrive at the root,
+          // then try to complete the transition to 1.
+          __root.__add_active();
+          if (__state_.compare_exchange_strong(
+                __old,
+                (__old & ~__count_mask) + __one,
+                std::memory_order_acq_rel,
+                std::memory_order_relaxed)) {
+            break;
+          }
+          ++__undo_arrivals;
+        }
+      }
+      for (; __undo_arrivals != 0; --__undo_arrivals) {
+        // The scope cannot become empty here, since this thread's arrival is counted.
+        __impl::__remove_active(&__root);
+      }
+    }
+
+    inline void __shard::__depart(const __impl* __root) noexcept {
+      std::uint64_t __old = __state_.load(std::memory_order_relaxed);
+      while (!__state_.compare_exchange_weak(
+        __old, __old - __one, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+      }
+      if ((__old & __count_mask) == __one) {
+        // do not access this
+        __impl::__remove_active(__root);
+      }
+    }
+
     ////////////////////////////////////////////////////////////////////////////
     // async_scope::when_empty implementation
     template <class _ReceiverId>
@@ -74,15 +417,9 @@ namespace exec {
       }
 
       void __start_() noexcept {
-        std::unique_lock __guard{this->__scope_->__lock_};
-        auto& __active = this->__scope_->__active_;
-        auto& __waiters = this->__scope_->__waiters_;
-        if (__active != 0) {
-          __waiters.push_back(this);
-          return;
+        if (!this->__scope_->__enqueue_waiter(this)) {
+          start(this->__op_);
         }
-        __guard.unlock();
-        start(this->__op_);
       }
 
       friend void tag_invoke(start_t, __when_empty_op& __self) noexcept {
@@ -131,6 +468,7 @@ namespace exec {
       using _Receiver = __t<_ReceiverId>;
       const __impl* __scope_;
       STDEXEC_NO_UNIQUE_ADDRESS _Receiver __rcvr_;
+      __shard* __shard_ = nullptr;
     };
 
     template <class _ReceiverId>
@@ -138,30 +476,15 @@ namespace exec {
       using _Receiver = __t<_ReceiverId>;
       __nest_op_base<_ReceiverId>* __op_;
 
-      static void __complete(const __impl* __scope) noexcept {
-        std::unique_lock __guard{__scope->__lock_};
-        auto& __active = __scope->__active_;
-        if (--__active == 0) {
-          auto __local = std::move(__scope->__waiters_);
-          __guard.unlock();
-          __scope = nullptr;
-          // do not access __scope
-          while (!__local.empty()) {
-            auto* __next = __local.pop_front();
-            __next->__notify_waiter(__next);
-            // __scope must be considered deleted
-          }
-        }
-      }
-
       template < __completion_tag _Tag, class... _As>
         requires __callable<_Tag, _Receiver, _As...>
       friend void tag_invoke(_Tag, __nest_rcvr&& __self, _As&&... __as) noexcept {
         auto __scope = __self.__op_->__scope_;
+        auto __shard = __self.__op_->__shard_;
         _Tag{}(std::move(__self.__op_->__rcvr_), (_As&&) __as...);
         // do not access __op_
         // do not access this
-        __complete(__scope);
+        __impl::__depart(__scope, __shard);
       }
 
       friend __env_t<env_of_t<_Receiver>>
@@ -172,25 +495,28 @@ namespace exec {
       }
     };
 
-    template <class _ConstrainedId, class _ReceiverId>
+    template <class _ConstrainedId, class _ReceiverId, class _Reservation>
     struct __nest_op : __nest_op_base<_ReceiverId> {
       using _Constrained = __t<_ConstrainedId>;
       using _Receiver = __t<_ReceiverId>;
       STDEXEC_IMMOVABLE_NO_UNIQUE_ADDRESS connect_result_t<_Constrained, __nest_rcvr<_ReceiverId>>
         __op_;
+      STDEXEC_NO_UNIQUE_ADDRESS _Reservation __reservation_;
 
       template <__decays_to<_Constrained> _Sender, __decays_to<_Receiver> _Rcvr>
-      explicit __nest_op(const __impl* __scope, _Sender&& __c, _Rcvr&& __rcvr)
+      explicit __nest_op(
+        const __impl* __scope,
+        _Sender&& __c,
+        _Rcvr&& __rcvr,
+        _Reservation&& __reservation)
         : __nest_op_base<_ReceiverId>{{}, __scope, (_Rcvr&&) __rcvr}
-        , __op_(connect((_Sender&&) __c, __nest_rcvr<_ReceiverId>{this})) {
+        , __op_(connect((_Sender&&) __c, __nest_rcvr<_ReceiverId>{this}))
+        , __reservation_((_Reservation&&) __reservation) {
       }
      private:
       void __start_() noexcept {
         STDEXEC_ASSERT(this->__scope_);
-        std::unique_lock __guard{this->__scope_->__lock_};
-        auto& __active = this->__scope_->__active_;
-        ++__active;
-        __guard.unlock();
+        this->__shard_ = this->__scope_->__arrive(__reservation_.__consume());
         start(__op_);
       }
 
@@ -199,25 +525,31 @@ namespace exec {
       }
     };
 
-    template <class _ConstrainedId>
+    template <class _ConstrainedId, class _Reservation = __no_reservation>
     struct __nest_sender {
       using _Constrained = __t<_ConstrainedId>;
       using is_sender = void;
 
       const __impl* __scope_;
       STDEXEC_NO_UNIQUE_ADDRESS _Constrained __c_;
+      STDEXEC_NO_UNIQUE_ADDRESS _Reservation __reservation_{};
 
       template <class _Receiver>
-      using __nest_operation_t = __nest_op<_ConstrainedId, __x<_Receiver>>;
+      using __nest_operation_t = __nest_op<_ConstrainedId, __x<_Receiver>, _Reservation>;
       template <class _Receiver>
       using __nest_receiver_t = __nest_rcvr<__x<_Receiver>>;
 
+      // A sender with a reservation is move-only, so that only one operation can consume it.
       template <__decays_to<__nest_sender> _Self, receiver _Receiver>
         requires sender_to<__copy_cvref_t<_Self, _Constrained>, __nest_receiver_t<_Receiver>>
+              && constructible_from<_Reservation, __copy_cvref_t<_Self, _Reservation>>
       [[nodiscard]] friend __nest_operation_t<_Receiver>
         tag_invoke(connect_t, _Self&& __self, _Receiver __rcvr) {
         return __nest_operation_t<_Receiver>{
-          __self.__scope_, ((_Self&&) __self).__c_, (_Receiver&&) __rcvr};
+          __self.__scope_,
+          ((_Self&&) __self).__c_,
+          (_Receiver&&) __rcvr,
+          ((_Self&&) __self).__reservation_};
       }
       template <__decays_to<__nest_sender> _Self, class _Env>
       friend auto tag_invoke(get_completion_signatures_t, _Self&&, _Env)
@@ -228,19 +560,11 @@ namespace exec {
       }
     };
 
-    template <class _Constrained>
-    using __nest_sender_t = __nest_sender<__x<__decay_t<_Constrained>>>;
+    template <class _Constrained, class _Reservation = __no_reservation>
+    using __nest_sender_t = __nest_sender<__x<__decay_t<_Constrained>>, _Reservation>;
 
     ////////////////////////////////////////////////////////////////////////////
     // async_scope::spawn_future implementation
-    enum class __future_step {
-      __invalid = 0,
-      __created,
-      __future,
-      __no_future,
-      __deleted
-    };
-
     template <class _Sender, class _Env>
     struct __future_state;
 
@@ -258,8 +582,6 @@ namespace exec {
       void __complete() noexcept {
         __complete_(this);
       }
-
-      __subscription* __next_ = nullptr;
     };
 
     template <class _SenderId, class _EnvId, class _ReceiverId>
@@ -279,27 +601,21 @@ namespace exec {
         try {
           auto __state = std::move(__state_);
           STDEXEC_ASSERT(__state != nullptr);
-          std::unique_lock __guard{__state->__mutex_};
           // either the future is still in use or it has passed ownership to __state->__no_future_
-          if (
-            __state->__no_future_.get() != nullptr || __state->__step_ != __future_step::__future) {
+          if (__state->__no_future_.get() != nullptr) {
             // invalid state - there is a code bug in the state machine
             std::terminate();
           } else if (get_stop_token(get_env(__rcvr_)).stop_requested()) {
-            __guard.unlock();
             set_stopped((_Receiver&&) __rcvr_);
-            __guard.lock();
           } else {
             std::visit(
-              [this, &__guard]<class _Tup>(_Tup& __tup) {
+              [this]<class _Tup>(_Tup& __tup) {
                 if constexpr (same_as<_Tup, std::monostate>) {
                   std::terminate();
                 } else {
                   std::apply(
-                    [this, &__guard]<class... _As>(auto tag, _As&... __as) {
-                      __guard.unlock();
+                    [this]<class... _As>(auto tag, _As&... __as) {
                       tag((_Receiver&&) __rcvr_, (_As&&) __as...);
-                      __guard.lock();
                     },
                     __tup);
                 }
@@ -312,18 +628,17 @@ namespace exec {
       }
 
       void __start_() noexcept {
-        try {
-          if (!!__state_) {
-            std::unique_lock __guard{__state_->__mutex_};
-            if (__state_->__data_.index() != 0) {
-              __guard.unlock();
-              __complete_();
-            } else {
-              __state_->__subscribers_.push_back(this);
-            }
+        if (!!__state_) {
+          // Publish this operation as the subscriber, unless the result is already there.
+          void* __expected = nullptr;
+          if (!__state_->__head_.compare_exchange_strong(
+                __expected,
+                static_cast<void*>(static_cast<__subscription*>(this)),
+                std::memory_order_acq_rel,
+                std::memory_order_acquire)) {
+            STDEXEC_ASSERT(__expected == __state_->__completed());
+            __complete_();
           }
-        } catch (...) {
-          set_error((_Receiver&&) __rcvr_, std::current_exception());
         }
       }
 
@@ -334,16 +649,7 @@ namespace exec {
      public:
       ~__future_op() noexcept {
         if (__state_ != nullptr) {
-          auto __raw_state = __state_.get();
-          std::unique_lock __guard{__raw_state->__mutex_};
-          if (__raw_state->__data_.index() > 0) {
-            // completed given sender
-            // state is no longer needed
-            return;
-          }
-          __raw_state->__no_future_ = std::move(__state_);
-          __raw_state->__step_from_to_(
-            __guard, __future_step::__future, __future_step::__no_future);
+          __state_->__abandon(std::move(__state_));
         }
       }
 
@@ -435,33 +741,37 @@ namespace exec {
             make_env((_Env&&) __env, with(get_stop_token, __scope->__stop_source_.get_token()))) {
       }
 
-      ~__future_state_base() {
-        std::unique_lock __guard{__mutex_};
-        if (__step_ == __future_step::__created) {
-          // exception during connect() will end up here
-          __step_from_to_(__guard, __future_step::__created, __future_step::__deleted);
-        } else if (__step_ != __future_step::__deleted) {
-          // completing the given sender before the future is dropped will end here
-          __step_from_to_(__guard, __future_step::__future, __future_step::__deleted);
-        }
+      // __head_ is nullptr until either side acts. The producer exchanges in __completed()
+      // once __data_ holds the result. The consumer either publishes its __subscription (on
+      // start) or exchanges in __abandoned() after handing ownership of the state to
+      // __no_future_ (when the future is dropped). Whoever comes second finishes the job.
+      void* __completed() const noexcept {
+        return const_cast<__future_state_base*>(this);
+      }
+
+      void* __abandoned() const noexcept {
+        return const_cast<void*>(static_cast<const void*>(&__no_future_));
       }
 
-      void __step_from_to_(
-        std::unique_lock<std::mutex>& __guard,
-        __future_step __from,
-        __future_step __to) {
-        STDEXEC_ASSERT(__guard.owns_lock());
-        auto actual = std::exchange(__step_, __to);
-        STDEXEC_ASSERT(actual == __from);
+      template <class _State>
+      static void __abandon(std::unique_ptr<_State> __state) noexcept {
+        __future_state_base* __self = __state.get();
+        __self->__no_future_ = std::move(__state);
+        void* __old = __self->__head_.exchange(__self->__abandoned(), std::memory_order_acq_rel);
+        if (__old == __self->__completed()) {
+          // completed given sender
+          // state is no longer needed
+          auto __owner = std::move(__self->__no_future_);
+        } else {
+          STDEXEC_ASSERT(__old == nullptr);
+        }
       }
 
       in_place_stop_source __stop_source_;
       std::optional<in_place_stop_callback<__forward_stopped>> __forward_scope_;
-      std::mutex __mutex_;
-      __future_step __step_ = __future_step::__created;
+      std::atomic<void*> __head_{nullptr};
       std::unique_ptr<__future_state_base, __dynamic_delete<__future_state_base>> __no_future_;
       __completions_as_variant<_Completions> __data_;
-      __intrusive_queue<&__subscription::__next_> __subscribers_;
       __env_t<_Env> __env_;
     };
 
@@ -474,21 +784,16 @@ namespace exec {
 
       void __dispatch_result_() noexcept {
         auto& __state = *__state_;
-        std::unique_lock __guard{__state.__mutex_};
-        auto __local = std::move(__state.__subscribers_);
         __state.__forward_scope_ = std::nullopt;
-        if (__state.__no_future_.get() != nullptr) {
+        void* __old = __state.__head_.exchange(__state.__completed(), std::memory_order_acq_rel);
+        if (__old == __state.__abandoned()) {
           // nobody is waiting for the results
-          // delete this and return
-          __state.__step_from_to_(__guard, __future_step::__no_future, __future_step::__deleted);
-          __guard.unlock();
-          __state.__no_future_.reset();
+          // delete the state and return
+          auto __owner = std::move(__state.__no_future_);
           return;
         }
-        __guard.unlock();
-        while (!__local.empty()) {
-          auto* __sub = __local.pop_front();
-          __sub->__complete();
+        if (__old != nullptr) {
+          static_cast<__subscription*>(__old)->__complete();
         }
       }
 
@@ -496,15 +801,13 @@ namespace exec {
       friend void tag_invoke(_Tag, __future_rcvr&& __self, _As&&... __as) noexcept {
         auto& __state = *__self.__state_;
         try {
-          std::unique_lock __guard{__state.__mutex_};
           using _Tuple = __decayed_tuple<_Tag, _As...>;
           __state.__data_.template emplace<_Tuple>(_Tag{}, (_As&&) __as...);
-          __guard.unlock();
-          __self.__dispatch_result_();
         } catch (...) {
           using _Tuple = std::tuple<set_error_t, std::exception_ptr>;
           __state.__data_.template emplace<_Tuple>(set_error_t{}, std::current_exception());
         }
+        __self.__dispatch_result_();
       }
 
       friend const __env_t<_Env>& tag_invoke(get_env_t, const __future_rcvr& __self) noexcept {
@@ -541,16 +844,7 @@ namespace exec {
 
       ~__future() noexcept {
         if (__state_ != nullptr) {
-          auto __raw_state = __state_.get();
-          std::unique_lock __guard{__raw_state->__mutex_};
-          if (__raw_state->__data_.index() != 0) {
-            // completed given sender
-            // state is no longer needed
-            return;
-          }
-          __raw_state->__no_future_ = std::move(__state_);
-          __raw_state->__step_from_to_(
-            __guard, __future_step::__future, __future_step::__no_future);
+          __state_->__abandon(std::move(__state_));
         }
       }
      private:
@@ -559,8 +853,6 @@ namespace exec {
 
       explicit __future(std::unique_ptr<__future_state<_Sender, _Env>> __state) noexcept
         : __state_(std::move(__state)) {
-        std::unique_lock __guard{__state_->__mutex_};
-        __state_->__step_from_to_(__guard, __future_step::__created, __future_step::__future);
       }
 
       template <__decays_to<__future> _Self, receiver _Receiver>
@@ -649,11 +941,89 @@ namespace exec {
     template <class _Sender, class _Env>
     using __spawn_operation_t = __spawn_op<__x<_Sender>, __x<_Env>>;
 
+    ////////////////////////////////////////////////////////////////////////////
+    // bounded_async_scope::acquire implementation
+    template <class _ReceiverId>
+    struct __acquire_op : __acquire_waiter {
+      using _Receiver = __t<_ReceiverId>;
+
+      struct __on_stop_requested {
+        __acquire_op* __op_;
+
+        void operator()() noexcept {
+          if (__op_->__bound_->__remove(__op_)) {
+            set_stopped((_Receiver&&) __op_->__rcvr_);
+          }
+        }
+      };
+
+      using __stop_token_t = stop_token_of_t<env_of_t<_Receiver>&>;
+      using __on_stop_t =
+        std::optional<typename __stop_token_t::template callback_type<__on_stop_requested>>;
+
+      __bound* __bound_;
+      STDEXEC_NO_UNIQUE_ADDRESS _Receiver __rcvr_;
+      __on_stop_t __on_stop_{};
+
+      __acquire_op(__bound* __bound, _Receiver&& __rcvr)
+        : __acquire_waiter{{}, [](__acquire_waiter* __self) noexcept {
+          auto* __op = static_cast<__acquire_op*>(__self);
+          __op->__on_stop_.reset();
+          set_value((_Receiver&&) __op->__rcvr_, __reservation{__op->__bound_});
+        }}
+        , __bound_{__bound}
+        , __rcvr_((_Receiver&&) __rcvr) {
+      }
+
+      friend void tag_invoke(start_t, __acquire_op& __self) noexcept {
+        using __result = __bound::__acquire_result;
+        __stop_token_t __token = get_stop_token(get_env(__self.__rcvr_));
+        // Register for stop requests before queuing. The callback does nothing unless the
+        // operation is queued.
+        __self.__on_stop_.emplace(__token, __on_stop_requested{&__self});
+        switch (__self.__bound_->__reserve_or_enqueue(&__self, __token)) {
+        case __result::__reserved:
+          __self.__complete_(&__self);
+          break;
+        case __result::__stopped:
+          __self.__on_stop_.reset();
+          set_stopped((_Receiver&&) __self.__rcvr_);
+          break;
+        case __result::__queued:
+          break;
+        }
+      }
+    };
+
+    struct __acquire_sender {
+      using is_sender = void;
+      using completion_signatures =
+        stdexec::completion_signatures<set_value_t(__reservation), set_stopped_t()>;
+
+      __bound* __bound_;
+
+      template <receiver_of<completion_signatures> _Receiver>
+      friend __acquire_op<__x<_Receiver>>
+        tag_invoke(connect_t, __acquire_sender __self, _Receiver __rcvr) {
+        return {__self.__bound_, (_Receiver&&) __rcvr};
+      }
+
+      friend empty_env tag_invoke(get_env_t, const __acquire_sender&) noexcept {
+        return {};
+      }
+    };
+
     ////////////////////////////////////////////////////////////////////////////
     // async_scope
     struct async_scope : __immovable {
       async_scope() = default;
 
+     protected:
+      async_scope(std::size_t __shard_count, std::size_t __max_in_flight)
+        : __impl_{__shard_count, __max_in_flight} {
+      }
+
+     public:
       template <sender _Constrained>
       [[nodiscard]] __when_empty_sender_t<_Constrained> when_empty(_Constrained&& __c) const {
         return __when_empty_sender_t<_Constrained>{&__impl_, (_Constrained&&) __c};
@@ -702,10 +1072,78 @@ namespace exec {
         return __impl_.__stop_source_.request_stop();
       }
 
-     private:
+     protected:
       __impl __impl_;
     };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // sharded_async_scope
+    //
+    // An async_scope whose count of active operations is spread across cache-line-sized
+    // shards, so that many threads nesting and completing work at once do not all contend on
+    // one atomic. when_empty() is still exact, and request_stop() still reaches every nested
+    // operation, since the shards feed the same shared counter and stop source.
+    struct sharded_async_scope : async_scope {
+      sharded_async_scope()
+        : sharded_async_scope(std::thread::hardware_concurrency()) {
+      }
+
+      explicit sharded_async_scope(std::size_t __shard_count)
+        : async_scope(std::max(__shard_count, std::size_t{1}), 0) {
+      }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    // bounded_async_scope
+    //
+    // An async_scope that limits the number of nested operations in flight. Producers apply
+    // backpressure by waiting on acquire(), which completes once a slot is free with a
+    // reservation of it. Passing the reservation to nest() or spawn() lets the nested
+    // operation take over the slot:
+    //
+    //   auto reservation = co_await scope.acquire();
+    //   scope.spawn(handle(message), std::move(reservation));
+    //
+    // A reservation that is destroyed or released before it is consumed gives the slot back.
+    // Nested operations started without a reservation still run, but count against the
+    // limit. acquire() completes with set_stopped if its receiver's stop token is triggered
+    // while waiting.
+    struct bounded_async_scope : async_scope {
+      using reservation = __reservation;
+
+      explicit bounded_async_scope(std::size_t __max_in_flight)
+        : async_scope(0, __max_in_flight) {
+        // Without a slot acquire() could never complete.
+        if (__max_in_flight == 0) {
+          throw std::invalid_argument("bounded_async_scope: max_in_flight must be positive");
+        }
+      }
+
+      [[nodiscard]] __acquire_sender acquire() noexcept {
+        return __acquire_sender{this->__impl_.__bound_.get()};
+      }
+
+      using async_scope::nest;
+
+      template <sender _Constrained>
+      [[nodiscard]] __nest_sender_t<_Constrained, reservation>
+        nest(_Constrained&& __c, reservation __reservation) {
+        return {&this->__impl_, (_Constrained&&) __c, std::move(__reservation)};
+      }
+
+      using async_scope::spawn;
+
+      template <__movable_value _Env = empty_env, sender_in<__env_t<_Env>> _Sender>
+        requires sender_to<__nest_sender_t<_Sender, reservation>, __spawn_receiver_t<_Env>>
+      void spawn(_Sender&& __sndr, reservation __reservation, _Env __env = {}) {
+        using __op_t = __spawn_operation_t<__nest_sender_t<_Sender, reservation>, _Env>;
+        stdexec::start(*new __op_t{
+          nest((_Sender&&) __sndr, std::move(__reservation)), (_Env&&) __env, &this->__impl_});
+      }
+    };
   } // namespace __scope
 
   using __scope::async_scope;
+  using __scope::sharded_async_scope;
+  using __scope::bounded_async_scope;
 } // namespace exec
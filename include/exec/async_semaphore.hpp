@@ -0,0 +1,305 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "../stdexec/execution.hpp"
+#include "__detail/__intrusive_list.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+namespace exec {
+  /////////////////////////////////////////////////////////////////////////////
+  // async_semaphore: a counting semaphore whose acquire(n) is a sender that
+  // completes once n permits have been taken, without blocking a thread while
+  // it waits.
+  //
+  //   exec::async_semaphore connections{8};
+  //   auto request = connections.acquire()
+  //                | ex::let_value([&] { return send_request(); })
+  //                | ex::then([&](auto reply) { connections.release(); ... });
+  //
+  // Waiting operations take their permits in the order in which they started,
+  // so one that needs many permits is not starved by later ones that need few.
+  // release(n) completes the operations that it satisfies on the releasing
+  // thread; acquire(n, sch) resumes on the scheduler sch instead. A waiting
+  // operation completes with set_stopped if its receiver's stop token is
+  // triggered, and leaves the queue in constant time.
+  //
+  // Taking and returning permits while no operation waits is a single atomic
+  // read-modify-write. A short internal lock guards the queue of waiting
+  // operations and is never held while one of them is completed.
+  namespace __semaphore {
+    using namespace stdexec;
+
+    struct __waiter : __immovable {
+      void (*__complete_)(__waiter*) noexcept;
+      __waiter* __prev_ = nullptr;
+      __waiter* __next_ = nullptr;
+      std::size_t __count_ = 0;
+      bool __queued_ = false;
+    };
+
+    using __waiter_list = __intrusive_list<&__waiter::__prev_, &__waiter::__next_>;
+
+    enum class __status {
+      __acquired,
+      __queued,
+      __stopped
+    };
+
+    struct __acquire_sender;
+
+    class async_semaphore : __immovable {
+     public:
+      explicit async_semaphore(std::size_t __permits) noexcept
+        : __state_{__permits * __one_permit} {
+      }
+
+      ~async_semaphore() {
+        STDEXEC_ASSERT(__waiters_.empty());
+      }
+
+      [[nodiscard]] __acquire_sender acquire(std::size_t __count = 1) noexcept;
+
+      template <scheduler _Scheduler>
+      [[nodiscard]] auto acquire(std::size_t __count, _Scheduler&& __sched);
+
+      // Takes the permits if they are available and no operation waits.
+      [[nodiscard]] bool try_acquire(std::size_t __count = 1) noexcept {
+        const std::uint64_t __needed = __count * __one_permit;
+        std::uint64_t __state = __state_.load(std::memory_order_relaxed);
+        while ((__state & __has_waiters) == 0 && __state >= __needed) {
+          if (__state_.compare_exchange_weak(
+                __state,
+                __state - __needed,
+                std::memory_order_acquire,
+                std::memory_order_relaxed)) {
+            return true;
+          }
+        }
+        return false;
+      }
+
+      void release(std::size_t __count = 1) noexcept {
+        const std::uint64_t __returned = __count * __one_permit;
+        std::uint64_t __state = __state_.load(std::memory_order_relaxed);
+        while ((__state & __has_waiters) == 0) {
+          if (__state_.compare_exchange_weak(
+                __state,
+                __state + __returned,
+                std::memory_order_release,
+                std::memory_order_relaxed)) {
+            return;
+          }
+        }
+        __waiter_list __granted;
+        {
+          std::unique_lock __guard{__lock_};
+          __grant(__returned, __granted);
+        }
+        __complete_all(__granted);
+      }
+
+      template <class _StopToken>
+      __status __acquire_or_enqueue(__waiter* __op, const _StopToken& __token) noexcept {
+        if (__token.stop_requested()) {
+          return __status::__stopped;
+        }
+        if (try_acquire(__op->__count_)) {
+          return __status::__acquired;
+        }
+        std::unique_lock __guard{__lock_};
+        // Checking under the lock orders this against a stop callback that tries to remove
+        // the operation before it is queued.
+        if (__token.stop_requested()) {
+          return __status::__stopped;
+        }
+        const std::uint64_t __needed = __op->__count_ * __one_permit;
+        std::uint64_t __state = __state_.load(std::memory_order_relaxed);
+        while (true) {
+          if ((__state & __has_waiters) == 0 && __state >= __needed) {
+            if (__state_.compare_exchange_weak(
+                  __state,
+                  __state - __needed,
+                  std::memory_order_acquire,
+                  std::memory_order_relaxed)) {
+              return __status::__acquired;
+            }
+          } else if (__state_.compare_exchange_weak(
+                       __state, __state | __has_waiters, std::memory_order_relaxed)) {
+            break;
+          }
+        }
+        __waiters_.push_back(__op);
+        __op->__queued_ = true;
+        return __status::__queued;
+      }
+
+      // Returns true if the operation was still waiting, in which case it will not be
+      // granted permits.
+      bool __remove(__waiter* __op) noexcept {
+        __waiter_list __granted;
+        {
+          std::unique_lock __guard{__lock_};
+          if (!__op->__queued_) {
+            return false;
+          }
+          __waiters_.erase(__op);
+          __op->__queued_ = false;
+          // The operations behind one that needed more permits than were available may be
+          // satisfied now.
+          __grant(0, __granted);
+        }
+        __complete_all(__granted);
+        return true;
+      }
+
+     private:
+      // The state holds the number of available permits shifted left by one, and sets the
+      // low bit while operations wait. While the bit is set the permits change only under
+      // __lock_, so that they are handed to the waiting operations in order.
+      static constexpr std::uint64_t __has_waiters = 1;
+      static constexpr std::uint64_t __one_permit = 2;
+
+      // Adds the returned permits and takes the waiting operations that they satisfy off
+      // the queue. Must be called with __lock_ held.
+      void __grant(std::uint64_t __returned, __waiter_list& __granted) noexcept {
+        std::uint64_t __state = __state_.load(std::memory_order_relaxed);
+        if (__waiters_.empty()) {
+          // The low bit may already be clear, in which case try_acquire and release can
+          // change the permits concurrently.
+          while (!__state_.compare_exchange_weak(
+            __state,
+            (__state + __returned) & ~__has_waiters,
+            std::memory_order_release,
+            std::memory_order_relaxed)) {
+          }
+          return;
+        }
+        // The low bit is set while operations wait, so the state does not change under us.
+        __state += __returned;
+        while (!__waiters_.empty() && __waiters_.front()->__count_ * __one_permit <= __state) {
+          __waiter* __op = __waiters_.pop_front();
+          __op->__queued_ = false;
+          __state -= __op->__count_ * __one_permit;
+          __granted.push_back(__op);
+        }
+        if (__waiters_.empty()) {
+          __state &= ~__has_waiters;
+        }
+        __state_.store(__state, std::memory_order_release);
+      }
+
+      static void __complete_all(__waiter_list& __granted) noexcept {
+        while (!__granted.empty()) {
+          __waiter* __op = __granted.pop_front();
+          __op->__complete_(__op);
+        }
+      }
+
+      std::atomic<std::uint64_t> __state_;
+      std::mutex __lock_;
+      __waiter_list __waiters_;
+    };
+
+    template <class _ReceiverId>
+    struct __operation : __waiter {
+      using _Receiver = __t<_ReceiverId>;
+
+      struct __on_stop_requested {
+        __operation* __op_;
+
+        void operator()() noexcept {
+          if (__op_->__semaphore_->__remove(__op_)) {
+            set_stopped((_Receiver&&) __op_->__rcvr_);
+          }
+        }
+      };
+
+      using __stop_token_t = stop_token_of_t<env_of_t<_Receiver>&>;
+      using __on_stop_t =
+        std::optional<typename __stop_token_t::template callback_type<__on_stop_requested>>;
+
+      async_semaphore* __semaphore_;
+      STDEXEC_NO_UNIQUE_ADDRESS _Receiver __rcvr_;
+      __on_stop_t __on_stop_{};
+
+      __operation(async_semaphore* __semaphore, std::size_t __count, _Receiver&& __rcvr)
+        : __waiter{{}, &__complete, nullptr, nullptr, __count}
+        , __semaphore_{__semaphore}
+        , __rcvr_((_Receiver&&) __rcvr) {
+      }
+
+      static void __complete(__waiter* __self) noexcept {
+        auto* __op = static_cast<__operation*>(__self);
+        __op->__on_stop_.reset();
+        set_value((_Receiver&&) __op->__rcvr_);
+      }
+
+      friend void tag_invoke(start_t, __operation& __self) noexcept {
+        __stop_token_t __token = get_stop_token(get_env(__self.__rcvr_));
+        // Register for stop requests before queuing. The callback does nothing unless the
+        // operation is queued.
+        __self.__on_stop_.emplace(__token, __on_stop_requested{&__self});
+        switch (__self.__semaphore_->__acquire_or_enqueue(&__self, __token)) {
+        case __status::__acquired:
+          __complete(&__self);
+          break;
+        case __status::__stopped:
+          __self.__on_stop_.reset();
+          set_stopped((_Receiver&&) __self.__rcvr_);
+          break;
+        case __status::__queued:
+          break;
+        }
+      }
+    };
+
+    struct __acquire_sender {
+      using is_sender = void;
+      using completion_signatures =
+        stdexec::completion_signatures<set_value_t(), set_stopped_t()>;
+
+      async_semaphore* __semaphore_;
+      std::size_t __count_;
+
+      template <receiver_of<completion_signatures> _Receiver>
+      friend __operation<__x<_Receiver>>
+        tag_invoke(connect_t, __acquire_sender __self, _Receiver __rcvr) {
+        return {__self.__semaphore_, __self.__count_, (_Receiver&&) __rcvr};
+      }
+
+      friend empty_env tag_invoke(get_env_t, const __acquire_sender&) noexcept {
+        return {};
+      }
+    };
+
+    inline __acquire_sender async_semaphore::acquire(std::size_t __count) noexcept {
+      return {this, __count};
+    }
+
+    template <scheduler _Scheduler>
+    auto async_semaphore::acquire(std::size_t __count, _Scheduler&& __sched) {
+      return transfer(acquire(__count), (_Scheduler&&) __sched);
+    }
+  } // namespace __semaphore
+
+  using __semaphore::async_semaphore;
+} // namespace exec
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "../stdexec/execution.hpp"
+#include "__detail/__bulk_range_fn.hpp"
+
+namespace exec {
+  /////////////////////////////////////////////////////////////////////////////
+  // bulk_chunked: like bulk, but the function is called with index ranges,
+  // fn(begin, end, args...), rather than once per index, so that the loop over
+  // the indices is in the caller's code where the compiler can vectorize it.
+  //
+  // Without a customization, the function is called once with [0, shape).
+  // A scheduler that customizes bulk gets the function adapted to bulk's
+  // per-index convention; static_thread_pool recognizes the adapted function
+  // and calls it once with the range each of its threads owns.
+  namespace __bulk_chunked {
+    using namespace stdexec;
+
+    // Run by the default bulk with a shape of one.
+    template <class _Shape, class _Fun>
+    struct __whole_range_fn {
+      _Shape __shape_;
+      _Fun __fn_;
+
+      template <class... _As>
+        requires __callable<_Fun&, _Shape, _Shape, _As&...>
+      void operator()(_Shape, _As&... __as) //
+        noexcept(__nothrow_callable<_Fun&, _Shape, _Shape, _As&...>) {
+        __fn_(_Shape{}, __shape_, __as...);
+      }
+    };
+
+    struct bulk_chunked_t {
+      template <sender _Sender, integral _Shape, __movable_value _Fun>
+        requires __tag_invocable_with_completion_scheduler<
+          bulk_chunked_t,
+          set_value_t,
+          _Sender,
+          _Shape,
+          _Fun>
+      sender auto operator()(_Sender&& __sndr, _Shape __shape, _Fun __fun) const noexcept(
+        nothrow_tag_invocable<
+          bulk_chunked_t,
+          __completion_scheduler_for<_Sender, set_value_t>,
+          _Sender,
+          _Shape,
+          _Fun>) {
+        auto __sched = get_completion_scheduler<set_value_t>(get_env(__sndr));
+        return tag_invoke(
+          bulk_chunked_t{},
+          std::move(__sched),
+          (_Sender&&) __sndr,
+          (_Shape&&) __shape,
+          (_Fun&&) __fun);
+      }
+
+      template <sender _Sender, integral _Shape, __movable_value _Fun>
+        requires(!__tag_invocable_with_completion_scheduler<
+                  bulk_chunked_t,
+                  set_value_t,
+                  _Sender,
+                  _Shape,
+                  _Fun>)
+             && tag_invocable<bulk_chunked_t, _Sender, _Shape, _Fun>
+      sender auto operator()(_Sender&& __sndr, _Shape __shape, _Fun __fun) const
+        noexcept(nothrow_tag_invocable<bulk_chunked_t, _Sender, _Shape, _Fun>) {
+        return tag_invoke(
+          bulk_chunked_t{}, (_Sender&&) __sndr, (_Shape&&) __shape, (_Fun&&) __fun);
+      }
+
+      template <sender _Sender, integral _Shape, __movable_value _Fun>
+        requires(!__tag_invocable_with_completion_scheduler<
+                  bulk_chunked_t,
+                  set_value_t,
+                  _Sender,
+                  _Shape,
+                  _Fun>)
+             && (!tag_invocable<bulk_chunked_t, _Sender, _Shape, _Fun>)
+             && __tag_invocable_with_completion_scheduler<
+                  bulk_t,
+                  set_value_t,
+                  _Sender,
+                  _Shape,
+                  __range_fn<_Fun>>
+      sender auto operator()(_Sender&& __sndr, _Shape __shape, _Fun __fun) const {
+        return bulk((_Sender&&) __sndr, __shape, __range_fn<_Fun>{(_Fun&&) __fun});
+      }
+
+      template <sender _Sender, integral _Shape, __movable_value _Fun>
+        requires(!__tag_invocable_with_completion_scheduler<
+                  bulk_chunked_t,
+                  set_value_t,
+                  _Sender,
+                  _Shape,
+                  _Fun>)
+             && (!tag_invocable<bulk_chunked_t, _Sender, _Shape, _Fun>)
+             && (!__tag_invocable_with_completion_scheduler<
+                  bulk_t,
+                  set_value_t,
+                  _Sender,
+                  _Shape,
+                  __range_fn<_Fun>>)
+      auto operator()(_Sender&& __sndr, _Shape __shape, _Fun __fun) const
+        -> bulk_t::__sender<_Sender, _Shape, __whole_range_fn<_Shape, _Fun>> {
+        return {
+          (_Sender&&) __sndr,
+          static_cast<_Shape>(__shape == 0 ? 0 : 1),
+          __whole_range_fn<_Shape, _Fun>{__shape, (_Fun&&) __fun}};
+      }
+
+      template <integral _Shape, class _Fun>
+      __binder_back<bulk_chunked_t, _Shape, _Fun> operator()(_Shape __shape, _Fun __fun) const {
+        return {
+          {},
+          {},
+          {(_Shape&&) __shape, (_Fun&&) __fun}
+        };
+      }
+    };
+  } // namespace __bulk_chunked
+
+  using __bulk_chunked::bulk_chunked_t;
+  inline constexpr bulk_chunked_t bulk_chunked{};
+} // namespace exec
@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "../stdexec/execution.hpp"
+#include "__detail/__intrusive_list.hpp"
+
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace exec {
+  /////////////////////////////////////////////////////////////////////////////
+  // channel<T>: a bounded multi-producer multi-consumer queue whose operations
+  // are senders. send(value) completes once the value is in the channel, and
+  // receive() completes with the oldest value in the channel; each waits while
+  // the channel is full or empty, and completes with set_stopped if its
+  // receiver's stop token is triggered while it waits.
+  //
+  //   exec::channel<int> ch{16};
+  //   scope.spawn(ex::on(producer, ch.send(42)));
+  //   auto [value] = ex::sync_wait(ch.receive()).value();
+  //
+  // A waiting operation is resumed on the thread of the operation that makes
+  // room or provides a value; transfer to a scheduler afterwards to choose.
+  // A channel of capacity zero hands each value from a sender to a receiver.
+  //
+  // close() makes the waiting and all later send operations complete with
+  // set_stopped. Receive operations take the values still in the channel
+  // first, and then complete with set_stopped too.
+  namespace __channel {
+    using namespace stdexec;
+
+    // An operation waiting in a channel's list of senders or of receivers.
+    struct __waiter : __immovable {
+      // Called outside of the channel's lock once the operation is done, or once the channel
+      // was closed.
+      void (*__complete_)(__waiter*, bool __closed) noexcept;
+      __waiter* __prev_ = nullptr;
+      __waiter* __next_ = nullptr;
+      bool __queued_ = false;
+    };
+
+    using __waiter_list = __intrusive_list<&__waiter::__prev_, &__waiter::__next_>;
+
+    // A send operation's value, or a receive operation's slot for one.
+    template <class _Tp>
+    struct __value_waiter : __waiter {
+      std::optional<_Tp> __value_;
+    };
+
+    enum class __status {
+      __done,
+      __queued,
+      __stopped
+    };
+
+    struct __result {
+      __status __status_;
+      // The waiting operation of the other kind that this one completed, if any.
+      __waiter* __woken_ = nullptr;
+    };
+
+    template <class _Tp>
+    struct __send_sender;
+
+    template <class _Tp>
+    struct __receive_sender;
+
+    template <class _Tp>
+    class channel : __immovable {
+      static_assert(
+        std::is_nothrow_move_constructible_v<_Tp>,
+        "channel moves values under its lock and requires a nothrow move constructor");
+
+     public:
+      explicit channel(std::size_t __capacity)
+        : __buffer_(__capacity) {
+      }
+
+      ~channel() {
+        STDEXEC_ASSERT(__senders_.empty());
+        STDEXEC_ASSERT(__receivers_.empty());
+      }
+
+      [[nodiscard]] __send_sender<_Tp> send(_Tp __value) {
+        return {this, std::move(__value)};
+      }
+
+      [[nodiscard]] __receive_sender<_Tp> receive() noexcept {
+        return {this};
+      }
+
+      void close() noexcept {
+        __waiter_list __senders;
+        __waiter_list __receivers;
+        {
+          std::unique_lock __guard{__lock_};
+          __closed_ = true;
+          __senders = __take_all(__senders_);
+          __receivers = __take_all(__receivers_);
+        }
+        __complete_all_closed(__senders);
+        __complete_all_closed(__receivers);
+      }
+
+      std::size_t capacity() const noexcept {
+        return __buffer_.size();
+      }
+
+      template <class _StopToken>
+      __result __send(__value_waiter<_Tp>* __op, const _StopToken& __token) noexcept {
+        std::unique_lock __guard{__lock_};
+        if (__token.stop_requested() || __closed_) {
+          return {__status::__stopped};
+        }
+        if (!__receivers_.empty()) {
+          // The buffer is empty, so the value goes to the oldest receiver directly.
+          auto* __receiver = static_cast<__value_waiter<_Tp>*>(__pop(__receivers_));
+          __receiver->__value_.emplace(std::move(*__op->__value_));
+          return {__status::__done, __receiver};
+        }
+        if (__size_ < __buffer_.size()) {
+          __buffer_[(__head_ + __size_++) % __buffer_.size()].emplace(std::move(*__op->__value_));
+          return {__status::__done};
+        }
+        __push(__senders_, __op);
+        return {__status::__queued};
+      }
+
+      template <class _StopToken>
+      __result __receive(__value_waiter<_Tp>* __op, const _StopToken& __token) noexcept {
+        std::unique_lock __guard{__lock_};
+        if (__token.stop_requested()) {
+          return {__status::__stopped};
+        }
+        if (__size_ != 0) {
+          std::optional<_Tp>& __front = __buffer_[__head_];
+          __op->__value_.emplace(std::move(*__front));
+          __front.reset();
+          __head_ = (__head_ + 1) % __buffer_.size();
+          --__size_;
+          if (__senders_.empty()) {
+            return {__status::__done};
+          }
+          // Move the value of the oldest sender into the room that was made.
+          auto* __sender = static_cast<__value_waiter<_Tp>*>(__pop(__senders_));
+          __buffer_[(__head_ + __size_++) % __buffer_.size()].emplace(
+            std::move(*__sender->__value_));
+          return {__status::__done, __sender};
+        }
+        if (!__senders_.empty()) {
+          // Only a channel of capacity zero has senders waiting while it is empty.
+          auto* __sender = static_cast<__value_waiter<_Tp>*>(__pop(__senders_));
+          __op->__value_.emplace(std::move(*__sender->__value_));
+          return {__status::__done, __sender};
+        }
+        if (__closed_) {
+          return {__status::__stopped};
+        }
+        __push(__receivers_, __op);
+        return {__status::__queued};
+      }
+
+      // Returns true if the operation was still waiting, in which case it will not be
+      // completed by the channel.
+      bool __remove(__waiter* __op, bool __is_sender) noexcept {
+        std::unique_lock __guard{__lock_};
+        if (!__op->__queued_) {
+          return false;
+        }
+        (__is_sender ? __senders_ : __receivers_).erase(__op);
+        __op->__queued_ = false;
+        return true;
+      }
+
+     private:
+      static void __push(__waiter_list& __list, __waiter* __op) noexcept {
+        __list.push_back(__op);
+        __op->__queued_ = true;
+      }
+
+      static __waiter* __pop(__waiter_list& __list) noexcept {
+        __waiter* __op = __list.pop_front();
+        __op->__queued_ = false;
+        return __op;
+      }
+
+      static __waiter_list __take_all(__waiter_list& __list) noexcept {
+        __waiter_list __result;
+        while (!__list.empty()) {
+          __result.push_back(__pop(__list));
+        }
+        return __result;
+      }
+
+      static void __complete_all_closed(__waiter_list& __list) noexcept {
+        while (!__list.empty()) {
+          __waiter* __op = __list.pop_front();
+          __op->__complete_(__op, true);
+        }
+      }
+
+      std::mutex __lock_;
+      std::vector<std::optional<_Tp>> __buffer_;
+      std::size_t __head_ = 0;
+      std::size_t __size_ = 0;
+      bool __closed_ = false;
+      __waiter_list __senders_;
+      __waiter_list __receivers_;
+    };
+
+    // The operation state shared by send and receive: registers for stop requests while
+    // the operation waits, and completes the operation it woke up before itself.
+    template <class _Tp, class _ReceiverId, bool _IsSender>
+    struct __operation : __value_waiter<_Tp> {
+      using _Receiver = __t<_ReceiverId>;
+
+      struct __on_stop_requested {
+        __operation* __op_;
+
+        void operator()() noexcept {
+          if (__op_->__channel_->__remove(__op_, _IsSender)) {
+            set_stopped((_Receiver&&) __op_->__rcvr_);
+          }
+        }
+      };
+
+      using __stop_token_t = stop_token_of_t<env_of_t<_Receiver>&>;
+      using __on_stop_t =
+        std::optional<typename __stop_token_t::template callback_type<__on_stop_requested>>;
+
+      channel<_Tp>* __channel_;
+      STDEXEC_NO_UNIQUE_ADDRESS _Receiver __rcvr_;
+      __on_stop_t __on_stop_{};
+
+      __operation(channel<_Tp>* __channel, std::optional<_Tp> __value, _Receiver&& __rcvr)
+        : __value_waiter<_Tp>{{{}, &__complete}, std::move(__value)}
+        , __channel_{__channel}
+        , __rcvr_((_Receiver&&) __rcvr) {
+      }
+
+      static void __complete(__waiter* __self, bool __closed) noexcept {
+        auto* __op = static_cast<__operation*>(__self);
+        __op->__on_stop_.reset();
+        if (__closed) {
+          set_stopped((_Receiver&&) __op->__rcvr_);
+        } else if constexpr (_IsSender) {
+          set_value((_Receiver&&) __op->__rcvr_);
+        } else {
+          set_value((_Receiver&&) __op->__rcvr_, std::move(*__op->__value_));
+        }
+      }
+
+      friend void tag_invoke(start_t, __operation& __self) noexcept {
+        __stop_token_t __token = get_stop_token(get_env(__self.__rcvr_));
+        // Register for stop requests before queuing. The callback does nothing unless the
+        // operation is queued.
+        __self.__on_stop_.emplace(__token, __on_stop_requested{&__self});
+        __result __result = _IsSender ? __self.__channel_->__send(&__self, __token)
+                                      : __self.__channel_->__receive(&__self, __token);
+        switch (__result.__status_) {
+        case __status::__done:
+          if (__result.__woken_) {
+            __result.__woken_->__complete_(__result.__woken_, false);
+          }
+          __complete(&__self, false);
+          break;
+        case __status::__stopped:
+          __complete(&__self, true);
+          break;
+        case __status::__queued:
+          break;
+        }
+      }
+    };
+
+    template <class _Tp>
+    struct __send_sender {
+      using is_sender = void;
+      using completion_signatures =
+        stdexec::completion_signatures<set_value_t(), set_stopped_t()>;
+
+      channel<_Tp>* __channel_;
+      _Tp __value_;
+
+      template <__decays_to<__send_sender> _Self, receiver_of<completion_signatures> _Receiver>
+        requires constructible_from<_Tp, __copy_cvref_t<_Self, _Tp>>
+      friend __operation<_Tp, __x<_Receiver>, true>
+        tag_invoke(connect_t, _Self&& __self, _Receiver __rcvr) {
+        return {__self.__channel_, ((_Self&&) __self).__value_, (_Receiver&&) __rcvr};
+      }
+
+      friend empty_env tag_invoke(get_env_t, const __send_sender&) noexcept {
+        return {};
+      }
+    };
+
+    template <class _Tp>
+    struct __receive_sender {
+      using is_sender = void;
+      using completion_signatures =
+        stdexec::completion_signatures<set_value_t(_Tp), set_stopped_t()>;
+
+      channel<_Tp>* __channel_;
+
+      template <receiver_of<completion_signatures> _Receiver>
+      friend __operation<_Tp, __x<_Receiver>, false>
+        tag_invoke(connect_t, __receive_sender __self, _Receiver __rcvr) {
+        return {__self.__channel_, std::nullopt, (_Receiver&&) __rcvr};
+      }
+
+      friend empty_env tag_invoke(get_env_t, const __receive_sender&) noexcept {
+        return {};
+      }
+    };
+  } // namespace __channel
+
+  using __channel::channel;
+} // namespace exec
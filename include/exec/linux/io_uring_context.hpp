@@ -22,6 +22,8 @@
 #include <linux/io_uring.h>
 
 #include "../../stdexec/execution.hpp"
+#include "../../stdexec/__detail/__queue_statistics.hpp"
+#include "../queue_statistics.hpp"
 #include "../timed_scheduler.hpp"
 
 #include "../__detail/__atomic_intrusive_queue.hpp"
@@ -138,6 +140,8 @@ namespace exec {
     struct __task : stdexec::__immovable {
       const __task_vtable* __vtable_;
       __task* __next_{nullptr};
+      // Stamped when the task is submitted, if the context keeps queue statistics.
+      std::uint64_t __enqueued_ns_{0};
 
       explicit __task(const __task_vtable& __vtable)
         : __vtable_{&__vtable} {
@@ -254,6 +258,11 @@ namespace exec {
         , __mask_{*__at_offset_as<__u32*>(__region.data(), __params.cq_off.ring_mask)} {
       }
 
+      // Set once the context keeps queue statistics. Only the tasks that are ready without
+      // going through the io_uring are recorded: the others wait for the kernel, not for the
+      // queue.
+      std::atomic<stdexec::__queue_stats::__recorder*> __stats_{nullptr};
+
       // This function first completes all tasks that are ready in the completion queue of the io_uring.
       // Then it completes all tasks that are ready in the given queue of ready tasks.
       // The function returns the number of previously submitted completed tasks.
@@ -272,10 +281,20 @@ namespace exec {
           __tail = __tail_.load(std::memory_order_acquire);
         }
         __head_.store(__head, std::memory_order_release);
+        stdexec::__queue_stats::__recorder* __stats = __ready.empty()
+                                                      ? nullptr
+                                                      : __stats_.load(std::memory_order_acquire);
         while (!__ready.empty()) {
           __task* __op = __ready.pop_front();
           ::io_uring_cqe __dummy_cqe{.user_data = bit_cast<__u64>(__op)};
-          __op->__vtable_->__complete_(__op, __dummy_cqe);
+          if (__stats) {
+            stdexec::__queue_stats::__run_recorded(
+              *__stats, __op->__enqueued_ns_, [&]() noexcept {
+                __op->__vtable_->__complete_(__op, __dummy_cqe);
+              });
+          } else {
+            __op->__vtable_->__complete_(__op, __dummy_cqe);
+          }
         }
         return __count;
       }
@@ -385,6 +404,9 @@ namespace exec {
           __stop(__op);
           return false;
         } else {
+          if (__completion_queue_.__stats_.load(std::memory_order_relaxed)) {
+            __op->__enqueued_ns_ = stdexec::__queue_stats::__now_ns();
+          }
           __requests_.push_front(__op);
           [[maybe_unused]] int __prev = __n_submissions_in_flight_.fetch_sub(
             1, std::memory_order_relaxed);
@@ -490,6 +512,23 @@ namespace exec {
         run();
       }
 
+      /// @brief Records how long scheduled tasks wait for the context and how long they run,
+      /// from now on. Not thread-safe with itself. See exec/queue_statistics.hpp.
+      void enable_queue_statistics() {
+        if (!__stats_storage_) {
+          __stats_storage_ = std::make_unique<stdexec::__queue_stats::__recorder>();
+          __completion_queue_.__stats_.store(__stats_storage_.get(), std::memory_order_release);
+        }
+      }
+
+      exec::queue_statistics queue_statistics() const noexcept {
+        exec::queue_statistics __result;
+        if (auto* __stats = __completion_queue_.__stats_.load(std::memory_order_acquire)) {
+          __result += *__stats;
+        }
+        return __result;
+      }
+
       __scheduler get_scheduler() noexcept;
 
      private:
@@ -504,6 +543,7 @@ namespace exec {
       std::atomic<bool> __break_loop_{false};
       std::ptrdiff_t __n_submitted_{0};
       std::optional<stdexec::in_place_stop_source> __stop_source_{std::in_place};
+      std::unique_ptr<stdexec::__queue_stats::__recorder> __stats_storage_;
       __completion_queue __completion_queue_;
       __submission_queue __submission_queue_;
       __task_queue __pending_{};
@@ -829,6 +869,7 @@ namespace exec {
         };
 
         __kernel_timespec __duration_;
+        __u32 __timeout_flags_;
 
         static constexpr __kernel_timespec
           __duration_to_timespec(std::chrono::nanoseconds dur) noexcept {
@@ -882,6 +923,7 @@ namespace exec {
           __sqe_.opcode = IORING_OP_TIMEOUT;
           __sqe_.addr = bit_cast<__u64>(&__duration_);
           __sqe_.len = 1;
+          __sqe_.timeout_flags = __timeout_flags_;
           __sqe = __sqe_;
 #else
           ::io_uring_sqe __sqe_{};
@@ -908,10 +950,17 @@ namespace exec {
           }
         }
 
-        __impl(__context& __context, std::chrono::nanoseconds __duration, _Receiver&& __receiver)
+        // If __absolute is true, __duration is the deadline as a time since the epoch of
+        // steady_clock, i.e. on CLOCK_MONOTONIC.
+        __impl(
+          __context& __context,
+          std::chrono::nanoseconds __duration,
+          [[maybe_unused]] bool __absolute,
+          _Receiver&& __receiver)
           : __stoppable_op_base<_Receiver>{__context, (_Receiver&&) __receiver}
 #ifdef STDEXEC_HAS_IO_URING_ASYNC_CANCELLATION
           , __duration_{__duration_to_timespec(__duration)}
+          , __timeout_flags_{__absolute ? IORING_TIMEOUT_ABS : 0u}
 #else
           , __timerfd_{::timerfd_create(CLOCK_REALTIME, 0)}
           , __duration_{__duration_to_timespec(__duration)}
@@ -991,6 +1040,7 @@ namespace exec {
 
         __schedule_env __env_;
         std::chrono::nanoseconds __duration_;
+        bool __absolute_ = false;
 
        private:
         friend __schedule_env
@@ -1020,6 +1070,7 @@ namespace exec {
             std::in_place,
             *__sender.__env_.__context_,
             __sender.__duration_,
+            __sender.__absolute_,
             (_Receiver&&) __receiver);
         }
       };
@@ -1046,6 +1097,16 @@ namespace exec {
         exec::schedule_at_t,
         const __scheduler& __sched,
         const std::chrono::time_point<_Clock, _Duration>& __time_point) {
+#ifdef STDEXEC_HAS_IO_URING_ASYNC_CANCELLATION
+        // A deadline on steady_clock is submitted as an absolute timeout, so that it does not
+        // move by the time that passes until the operation is started.
+        if constexpr (std::same_as<_Clock, std::chrono::steady_clock>) {
+          return __schedule_after_sender{
+            .__env_ = {__sched.__context_},
+            .__duration_ = __time_point.time_since_epoch(),
+            .__absolute_ = true};
+        }
+#endif
         auto __duration = __time_point - _Clock::now();
         return __schedule_after_sender{.__env_ = {__sched.__context_}, .__duration_ = __duration};
       }
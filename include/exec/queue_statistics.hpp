@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "../stdexec/execution.hpp"
+#include "../stdexec/__detail/__queue_statistics.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <utility>
+
+// Optional queue statistics of the execution contexts. Once enabled on a context, every task
+// that goes through its queue is stamped when it is enqueued, and the worker that dequeues it
+// records how long it waited (the queue delay) and how long it ran (the service time) into
+// histograms of its own. Reading the statistics merges the histograms of all workers without
+// stopping them.
+//
+//   exec::static_thread_pool pool{8};
+//   pool.enable_queue_statistics();
+//   ...
+//   exec::queue_statistics stats = exec::get_queue_statistics(pool);
+//   std::uint64_t p99_ns = stats.queue_delay.percentile(99.0);
+//
+// Statistics are off by default and cost a branch per task when they are off.
+namespace exec {
+  // A snapshot of a histogram of durations in nanoseconds. Values are kept in log-linear
+  // buckets, so a reported value is at most about 3% above the recorded one.
+  class latency_histogram {
+    std::array<std::uint64_t, stdexec::__queue_stats::__bucket_count> __counts_{};
+
+   public:
+    latency_histogram() = default;
+
+    explicit latency_histogram(const stdexec::__queue_stats::__histogram& __hist) noexcept {
+      *this += __hist;
+    }
+
+    latency_histogram& operator+=(const stdexec::__queue_stats::__histogram& __hist) noexcept {
+      for (std::size_t __i = 0; __i < __counts_.size(); ++__i) {
+        __counts_[__i] += __hist.__counts_[__i].load(std::memory_order_relaxed);
+      }
+      return *this;
+    }
+
+    latency_histogram& operator+=(const latency_histogram& __other) noexcept {
+      for (std::size_t __i = 0; __i < __counts_.size(); ++__i) {
+        __counts_[__i] += __other.__counts_[__i];
+      }
+      return *this;
+    }
+
+    // The number of recorded values.
+    std::uint64_t count() const noexcept {
+      std::uint64_t __total = 0;
+      for (std::uint64_t __n: __counts_) {
+        __total += __n;
+      }
+      return __total;
+    }
+
+    // The smallest value that is not less than the given percentage of the recorded values,
+    // rounded up to the end of its bucket, or 0 if nothing was recorded.
+    std::uint64_t percentile(double __percent) const noexcept {
+      const std::uint64_t __total = count();
+      if (__total == 0) {
+        return 0;
+      }
+      const double __clamped = std::clamp(__percent, 0.0, 100.0);
+      const auto __rank = std::max<std::uint64_t>(
+        1, static_cast<std::uint64_t>(__clamped / 100.0 * static_cast<double>(__total) + 0.5));
+      std::uint64_t __seen = 0;
+      for (std::size_t __i = 0; __i < __counts_.size(); ++__i) {
+        __seen += __counts_[__i];
+        if (__seen >= __rank) {
+          return stdexec::__queue_stats::__bucket_upper_bound(__i);
+        }
+      }
+      return max();
+    }
+
+    // The largest recorded value, rounded up to the end of its bucket.
+    std::uint64_t max() const noexcept {
+      for (std::size_t __i = __counts_.size(); __i > 0; --__i) {
+        if (__counts_[__i - 1] != 0) {
+          return stdexec::__queue_stats::__bucket_upper_bound(__i - 1);
+        }
+      }
+      return 0;
+    }
+  };
+
+  struct queue_statistics {
+    // From enqueueing a task to starting to run it.
+    latency_histogram queue_delay;
+    // From starting to run a task to returning from it.
+    latency_histogram service_time;
+
+    queue_statistics& operator+=(const stdexec::__queue_stats::__recorder& __rec) noexcept {
+      queue_delay += __rec.__queue_delay_;
+      service_time += __rec.__service_time_;
+      return *this;
+    }
+
+    queue_statistics& operator+=(const queue_statistics& __other) noexcept {
+      queue_delay += __other.queue_delay;
+      service_time += __other.service_time;
+      return *this;
+    }
+  };
+
+  // run_loop is a standard type, so its statistics are reached through free functions
+  // rather than members.
+  inline void enable_queue_statistics(stdexec::run_loop& __loop) {
+    __loop.__enable_queue_statistics();
+  }
+
+  inline queue_statistics get_queue_statistics(const stdexec::run_loop& __loop) noexcept {
+    queue_statistics __stats;
+    if (const stdexec::__queue_stats::__recorder* __rec = __loop.__queue_statistics()) {
+      __stats += *__rec;
+    }
+    return __stats;
+  }
+
+  // A static_thread_pool keeps a recorder per worker thread. Its statistics are read here
+  // so that the pool does not depend on this header.
+  template <class _Context>
+    requires std::ranges::range<decltype(std::declval<const _Context&>().__queue_statistics())>
+  queue_statistics get_queue_statistics(const _Context& __context) noexcept {
+    queue_statistics __stats;
+    for (const stdexec::__queue_stats::__recorder& __rec: __context.__queue_statistics()) {
+      __stats += __rec;
+    }
+    return __stats;
+  }
+} // namespace exec
@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "../stdexec/execution.hpp"
+#include "static_thread_pool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+namespace exec {
+  /////////////////////////////////////////////////////////////////////////////
+  // reduce / transform_reduce: the predecessor sends a sized random access
+  // range, and the sender completes with init reduced with the (transformed)
+  // elements of the range.
+  //
+  // The elements are always combined in range order, although not
+  // necessarily from left to right, so the result for an associative
+  // operation is the same with or without a parallel customization.
+  namespace __reduce {
+    using namespace stdexec;
+
+    template <class _Range>
+    concept __reducible_range = //
+      std::ranges::random_access_range<_Range> && std::ranges::sized_range<_Range>;
+
+    template <class _Tp, class _ReduceOp, class _TransformOp, class _Iterator>
+    _Tp __fold(
+      _Iterator __first,
+      _Iterator __last,
+      _Tp __init,
+      _ReduceOp& __reduce,
+      _TransformOp& __transform) {
+      for (; __first != __last; ++__first) {
+        __init = __reduce(std::move(__init), __transform(*__first));
+      }
+      return __init;
+    }
+
+    template <class _Tp, class _ReduceOp, class _TransformOp>
+    struct __sequential_fn {
+      _Tp __init_;
+      _ReduceOp __reduce_;
+      _TransformOp __transform_;
+
+      template <__reducible_range _Range>
+      _Tp operator()(_Range&& __range) {
+        return __reduce::__fold(
+          std::ranges::begin(__range),
+          std::ranges::end(__range),
+          std::move(__init_),
+          __reduce_,
+          __transform_);
+      }
+    };
+
+    /////////////////////////////////////////////////////////////////////////////
+    // The parallel algorithm for schedulers that customize bulk: one bulk index
+    // per chunk, each reducing its chunk into its own cache line, followed by
+    // a pairwise combination of the partial results in range order.
+    inline constexpr std::size_t __cache_line_size = 64;
+
+    template <class _Range, class _Tp>
+    struct __chunked_state {
+      struct alignas(__cache_line_size) __partial {
+        std::optional<_Tp> __value_;
+      };
+
+      _Range __range_;
+      std::vector<__partial> __partials_;
+
+      // Chunk __i of __partials_.size(), split like static_thread_pool's even_share.
+      std::pair<std::size_t, std::size_t> __chunk(std::size_t __i) const noexcept {
+        const std::size_t __size = static_cast<std::size_t>(std::ranges::size(__range_));
+        const std::size_t __count = __partials_.size();
+        const std::size_t __per_chunk = __size / __count;
+        const std::size_t __remainder = __size % __count;
+        const std::size_t __begin = __i * __per_chunk + (std::min)(__i, __remainder);
+        return {__begin, __begin + __per_chunk + (__i < __remainder ? 1 : 0)};
+      }
+    };
+
+    template <class _Tp>
+    struct __make_state_fn {
+      std::size_t __chunks_;
+
+      template <__reducible_range _Range>
+      __chunked_state<__decay_t<_Range>, _Tp> operator()(_Range&& __range) const {
+        using __state_t = __chunked_state<__decay_t<_Range>, _Tp>;
+        return {(_Range&&) __range, std::vector<typename __state_t::__partial>(__chunks_)};
+      }
+    };
+
+    template <class _ReduceOp, class _TransformOp>
+    struct __chunk_fn {
+      _ReduceOp __reduce_;
+      _TransformOp __transform_;
+
+      template <class _Range, class _Tp>
+      void operator()(std::size_t __i, __chunked_state<_Range, _Tp>& __state) {
+        auto [__begin, __end] = __state.__chunk(__i);
+        if (__begin == __end) {
+          return;
+        }
+        auto __first = std::ranges::begin(__state.__range_);
+        _Tp __partial(__transform_(__first[__begin]));
+        __state.__partials_[__i].__value_.emplace(__reduce::__fold(
+          __first + __begin + 1, __first + __end, std::move(__partial), __reduce_, __transform_));
+      }
+    };
+
+    template <class _Tp, class _ReduceOp>
+    struct __combine_fn {
+      _Tp __init_;
+      _ReduceOp __reduce_;
+
+      template <class _Range>
+      _Tp operator()(__chunked_state<_Range, _Tp>&& __state) {
+        // Only the leading chunks are non-empty.
+        auto& __partials = __state.__partials_;
+        const std::size_t __used = (std::min)(
+          __partials.size(), static_cast<std::size_t>(std::ranges::size(__state.__range_)));
+        if (__used == 0) {
+          return std::move(__init_);
+        }
+        for (std::size_t __stride = 1; __stride < __used; __stride *= 2) {
+          for (std::size_t __i = 0; __i + __stride < __used; __i += 2 * __stride) {
+            __partials[__i].__value_.emplace(__reduce_(
+              std::move(*__partials[__i].__value_),
+              std::move(*__partials[__i + __stride].__value_)));
+          }
+        }
+        return __reduce_(std::move(__init_), std::move(*__partials[0].__value_));
+      }
+    };
+
+    // For use by schedulers that customize transform_reduce in terms of their bulk.
+    template <sender _Sender, class _Tp, class _ReduceOp, class _TransformOp>
+    auto __chunked_transform_reduce(
+      _Sender&& __sndr,
+      std::size_t __chunks,
+      _Tp __init,
+      _ReduceOp __reduce,
+      _TransformOp __transform) {
+      return then(
+        bulk(
+          then((_Sender&&) __sndr, __make_state_fn<_Tp>{__chunks == 0 ? 1 : __chunks}),
+          __chunks == 0 ? 1 : __chunks,
+          __chunk_fn<_ReduceOp, _TransformOp>{__reduce, (_TransformOp&&) __transform}),
+        __combine_fn<_Tp, _ReduceOp>{(_Tp&&) __init, (_ReduceOp&&) __reduce});
+    }
+
+    struct transform_reduce_t {
+      template <sender _Sender, class _Tp, __movable_value _ReduceOp, __movable_value _TransformOp>
+        requires __tag_invocable_with_completion_scheduler<
+          transform_reduce_t,
+          set_value_t,
+          _Sender,
+          _Tp,
+          _ReduceOp,
+          _TransformOp>
+      sender auto operator()(
+        _Sender&& __sndr,
+        _Tp __init,
+        _ReduceOp __reduce,
+        _TransformOp __transform) const
+        noexcept(nothrow_tag_invocable<
+                 transform_reduce_t,
+                 __completion_scheduler_for<_Sender, set_value_t>,
+                 _Sender,
+                 _Tp,
+                 _ReduceOp,
+                 _TransformOp>) {
+        auto __sched = get_completion_scheduler<set_value_t>(get_env(__sndr));
+        return tag_invoke(
+          transform_reduce_t{},
+          std::move(__sched),
+          (_Sender&&) __sndr,
+          (_Tp&&) __init,
+          (_ReduceOp&&) __reduce,
+          (_TransformOp&&) __transform);
+      }
+
+      template <sender _Sender, class _Tp, __movable_value _ReduceOp, __movable_value _TransformOp>
+        requires(!__tag_invocable_with_completion_scheduler<
+                  transform_reduce_t,
+                  set_value_t,
+                  _Sender,
+                  _Tp,
+                  _ReduceOp,
+                  _TransformOp>)
+             && tag_invocable<transform_reduce_t, _Sender, _Tp, _ReduceOp, _TransformOp>
+      sender auto operator()(
+        _Sender&& __sndr,
+        _Tp __init,
+        _ReduceOp __reduce,
+        _TransformOp __transform) const
+        noexcept(nothrow_tag_invocable<transform_reduce_t, _Sender, _Tp, _ReduceOp, _TransformOp>) {
+        return tag_invoke(
+          transform_reduce_t{},
+          (_Sender&&) __sndr,
+          (_Tp&&) __init,
+          (_ReduceOp&&) __reduce,
+          (_TransformOp&&) __transform);
+      }
+
+      template <sender _Sender, class _Tp, __movable_value _ReduceOp, __movable_value _TransformOp>
+        requires(!__tag_invocable_with_completion_scheduler<
+                  transform_reduce_t,
+                  set_value_t,
+                  _Sender,
+                  _Tp,
+                  _ReduceOp,
+                  _TransformOp>)
+             && (!tag_invocable<transform_reduce_t, _Sender, _Tp, _ReduceOp, _TransformOp>)
+      auto operator()(
+        _Sender&& __sndr,
+        _Tp __init,
+        _ReduceOp __reduce,
+        _TransformOp __transform) const
+        -> then_t::__sender<_Sender, __sequential_fn<_Tp, _ReduceOp, _TransformOp>> {
+        return {
+          (_Sender&&) __sndr,
+          __sequential_fn<_Tp, _ReduceOp, _TransformOp>{
+            (_Tp&&) __init, (_ReduceOp&&) __reduce, (_TransformOp&&) __transform}
+        };
+      }
+
+      template <class _Tp, class _ReduceOp, class _TransformOp>
+      __binder_back<transform_reduce_t, _Tp, _ReduceOp, _TransformOp>
+        operator()(_Tp __init, _ReduceOp __reduce, _TransformOp __transform) const {
+        return {
+          {},
+          {},
+          {(_Tp&&) __init, (_ReduceOp&&) __reduce, (_TransformOp&&) __transform}
+        };
+      }
+
+      // On a static_thread_pool: one chunk per thread, reduced in place and then combined
+      // pairwise.
+      template <sender _Sender, class _Tp, class _ReduceOp, class _TransformOp>
+      friend auto tag_invoke(
+        transform_reduce_t,
+        const static_thread_pool::scheduler& __sched,
+        _Sender&& __sndr,
+        _Tp __init,
+        _ReduceOp __reduce,
+        _TransformOp __transform) {
+        return __reduce::__chunked_transform_reduce(
+          (_Sender&&) __sndr,
+          __sched.__available_parallelism(),
+          (_Tp&&) __init,
+          (_ReduceOp&&) __reduce,
+          (_TransformOp&&) __transform);
+      }
+    };
+
+    // reduce is transform_reduce with the identity transformation; schedulers
+    // customize transform_reduce to get both.
+    struct reduce_t {
+      template <sender _Sender, class _Tp, __movable_value _ReduceOp = std::plus<>>
+      sender auto operator()(_Sender&& __sndr, _Tp __init, _ReduceOp __reduce = {}) const {
+        return transform_reduce_t{}(
+          (_Sender&&) __sndr, (_Tp&&) __init, (_ReduceOp&&) __reduce, std::identity{});
+      }
+
+      template <class _Tp, class _ReduceOp = std::plus<>>
+        requires(!sender<_Tp>)
+      __binder_back<reduce_t, _Tp, _ReduceOp>
+        operator()(_Tp __init, _ReduceOp __reduce = {}) const {
+        return {
+          {},
+          {},
+          {(_Tp&&) __init, (_ReduceOp&&) __reduce}
+        };
+      }
+    };
+  } // namespace __reduce
+
+  using __reduce::transform_reduce_t;
+  inline constexpr transform_reduce_t transform_reduce{};
+
+  using __reduce::reduce_t;
+  inline constexpr reduce_t reduce{};
+} // namespace exec
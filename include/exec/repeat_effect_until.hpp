@@ -17,13 +17,11 @@
 #pragma once
 
 #include "../stdexec/execution.hpp"
-#include "exec/trampoline_scheduler.hpp"
-#include "exec/on.hpp"
+#include "__detail/__loop_frame.hpp"
 #include "__detail/__manual_lifetime.hpp"
 #include "stdexec/__detail/__meta.hpp"
 #include "stdexec/concepts.hpp"
 #include "stdexec/functional.hpp"
-#include "trampoline_scheduler.hpp"
 #include <concepts>
 
 namespace exec {
@@ -35,6 +33,10 @@ namespace exec {
       struct __t;
     };
 
+    // Each iteration connects and starts the source. While the source completes
+    // synchronously from within start(), on the thread running the loop, the next iteration
+    // runs in the same loop instead of nesting on the stack (see __loop_frame). When it
+    // completes some other way, the completing call runs a new loop.
     template <class _SourceId, class _ReceiverId>
     struct __operation {
       using _Source = stdexec::__t<_SourceId>;
@@ -43,29 +45,54 @@ namespace exec {
       struct __t : stdexec::__immovable {
         using __id = __operation;
         using __receiver_t = stdexec::__t<__receiver<_SourceId, _ReceiverId>>;
-        using __source_on_scheduler_sender =
-          __call_result_t<stdexec::on_t, trampoline_scheduler, _Source &>;
-        using __source_op_t = stdexec::connect_result_t<__source_on_scheduler_sender, __receiver_t>;
+        using __source_op_t = stdexec::connect_result_t<_Source &, __receiver_t>;
 
         STDEXEC_NO_UNIQUE_ADDRESS _Source __source_;
         STDEXEC_NO_UNIQUE_ADDRESS _Receiver __rcvr_;
         __manual_lifetime<__source_op_t> __source_op_;
-        trampoline_scheduler __sched_;
 
         template <class _Source2>
         __t(_Source2 &&__source, _Receiver __rcvr) noexcept(
-          __nothrow_decay_copyable<_Source2> &&__nothrow_decay_copyable<_Receiver>
-            &&nothrow_tag_invocable<stdexec::on_t, trampoline_scheduler, _Source>
-              &&__nothrow_connectable<__source_on_scheduler_sender, __receiver_t>)
+          __nothrow_decay_copyable<_Source2> &&__nothrow_decay_copyable<_Receiver>)
           : __source_((_Source2 &&) __source)
           , __rcvr_((_Receiver &&) __rcvr) {
-          __source_op_.__construct_with([&] {
-            return stdexec::connect(stdexec::on(__sched_, __source_), __receiver_t{this});
-          });
+        }
+
+        bool __stop_requested() const noexcept {
+          if constexpr (unstoppable_token<stop_token_of_t<env_of_t<_Receiver>>>) {
+            return false;
+          } else {
+            return get_stop_token(get_env(__rcvr_)).stop_requested();
+          }
+        }
+
+        void __repeat() noexcept {
+          __loop_frame __frame{this};
+          do {
+            if (__stop_requested()) {
+              stdexec::set_stopped((_Receiver &&) __rcvr_);
+              break;
+            }
+            try {
+              auto &__source_op = __source_op_.__construct_with(
+                [&] { return stdexec::connect(__source_, __receiver_t{this}); });
+              stdexec::start(__source_op);
+            } catch (...) {
+              stdexec::set_error((_Receiver &&) __rcvr_, std::current_exception());
+              break;
+            }
+          } while (__frame.__again());
+        }
+
+        // Called after the source asked for another iteration.
+        void __next() noexcept {
+          if (!__loop_frame::__resume(this)) {
+            __repeat();
+          }
         }
 
         friend void tag_invoke(stdexec::start_t, __t &__self) noexcept {
-          stdexec::start(__self.__source_op_.__get());
+          __self.__repeat();
         }
       };
     };
@@ -104,14 +131,7 @@ namespace exec {
         if (__done) {
           stdexec::set_value((_Receiver &&) __op->__rcvr_);
         } else {
-          try {
-            auto &__source_op = __op->__source_op_.__construct_with([&]() {
-              return stdexec::connect(stdexec::on(__op->__sched_, __op->__source_), __t{__op});
-            });
-            stdexec::start(__source_op);
-          } catch (...) {
-            stdexec::set_error((_Receiver &&) __op->__rcvr_, std::current_exception());
-          }
+          __op->__next();
         }
       }
 
@@ -160,11 +180,10 @@ namespace exec {
           stdexec::make_completion_signatures<
             _Source &,
             _Env,
-            stdexec::make_completion_signatures<
-              stdexec::schedule_result_t<exec::trampoline_scheduler>,
-              _Env,
-              completion_signatures<set_error_t(std::exception_ptr), stdexec::set_value_t()>,
-              __value_t>,
+            completion_signatures<
+              set_error_t(std::exception_ptr),
+              set_stopped_t(),
+              stdexec::set_value_t()>,
             __value_t>;
 
         template <__decays_to<__t> _Self, class _Env>
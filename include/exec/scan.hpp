@@ -0,0 +1,355 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "../stdexec/execution.hpp"
+#include "reduce.hpp"
+#include "static_thread_pool.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <utility>
+
+namespace exec {
+  /////////////////////////////////////////////////////////////////////////////
+  // inclusive_scan / exclusive_scan: the predecessor sends a sized random
+  // access range, and the sender completes with the range replaced by its
+  // prefix sums under the given operation.
+  //
+  // Whatever the scheduler, the scan works on a decayed copy of the range,
+  // which is moved from an rvalue. A range sent as an lvalue reference is
+  // left unchanged, while a view like std::span scans the elements it
+  // refers to in place.
+  //
+  // As with reduce, the elements are combined in range order, so the result
+  // for an associative operation does not depend on the scheduler.
+  namespace __scan {
+    using namespace stdexec;
+
+    template <class _Range>
+    concept __scannable_range = //
+      __reduce::__reducible_range<_Range>
+      && std::indirectly_writable<
+        std::ranges::iterator_t<_Range>,
+        std::ranges::range_value_t<_Range>>;
+
+    template <class _Op>
+    struct __sequential_inclusive_fn {
+      _Op __op_;
+
+      template <__scannable_range _Range>
+      __decay_t<_Range> operator()(_Range&& __range) {
+        __decay_t<_Range> __result = (_Range&&) __range;
+        auto __first = std::ranges::begin(__result);
+        std::inclusive_scan(__first, std::ranges::end(__result), __first, __op_);
+        return __result;
+      }
+    };
+
+    template <class _Tp, class _Op>
+    struct __sequential_exclusive_fn {
+      _Tp __init_;
+      _Op __op_;
+
+      template <__scannable_range _Range>
+      __decay_t<_Range> operator()(_Range&& __range) {
+        __decay_t<_Range> __result = (_Range&&) __range;
+        auto __first = std::ranges::begin(__result);
+        std::exclusive_scan(
+          __first, std::ranges::end(__result), __first, std::move(__init_), __op_);
+        return __result;
+      }
+    };
+
+    /////////////////////////////////////////////////////////////////////////////
+    // The parallel algorithm for schedulers that customize bulk, in three
+    // steps: a bulk that reduces each chunk into its partial, a scan of the
+    // partials into the offset of each chunk, and a bulk that scans each
+    // chunk again starting from its offset. The state and the first step are
+    // those of reduce.
+
+    // The state of an inclusive scan accumulates in the value type of the range.
+    struct __make_inclusive_state_fn {
+      std::size_t __chunks_;
+
+      template <__scannable_range _Range>
+      auto operator()(_Range&& __range) const {
+        using _Tp = std::ranges::range_value_t<_Range>;
+        return __reduce::__make_state_fn<_Tp>{__chunks_}((_Range&&) __range);
+      }
+    };
+
+    // The init of an inclusive scan.
+    struct __no_init { };
+
+    // Replaces the partial of each chunk by the combination of init and of the
+    // partials of the chunks before it.
+    template <class _Init, class _Op>
+    struct __offsets_fn {
+      _Init __init_;
+      _Op __op_;
+
+      template <class _Range, class _Tp>
+      __reduce::__chunked_state<_Range, _Tp>
+        operator()(__reduce::__chunked_state<_Range, _Tp>&& __state) {
+        std::optional<_Tp> __running;
+        if constexpr (!same_as<_Init, __no_init>) {
+          __running.emplace(std::move(__init_));
+        }
+        for (auto& __partial: __state.__partials_) {
+          if (!__partial.__value_) {
+            // Only the leading chunks are non-empty.
+            break;
+          }
+          std::optional<_Tp> __offset = std::move(__running);
+          if (__offset) {
+            __running.emplace(__op_(*__offset, std::move(*__partial.__value_)));
+          } else {
+            __running.emplace(std::move(*__partial.__value_));
+          }
+          __partial.__value_ = std::move(__offset);
+        }
+        return std::move(__state);
+      }
+    };
+
+    template <class _Init, class _Op>
+    struct __rescan_fn {
+      _Op __op_;
+
+      template <class _Range, class _Tp>
+      void operator()(std::size_t __i, __reduce::__chunked_state<_Range, _Tp>& __state) {
+        auto [__begin, __end] = __state.__chunk(__i);
+        if (__begin == __end) {
+          return;
+        }
+        auto __first = std::ranges::begin(__state.__range_) + __begin;
+        auto __last = std::ranges::begin(__state.__range_) + __end;
+        std::optional<_Tp>& __offset = __state.__partials_[__i].__value_;
+        if constexpr (same_as<_Init, __no_init>) {
+          _Tp __running = __offset ? __op_(std::move(*__offset), *__first) : _Tp(*__first);
+          *__first = __running;
+          while (++__first != __last) {
+            __running = __op_(std::move(__running), *__first);
+            *__first = __running;
+          }
+        } else {
+          _Tp __running = std::move(*__offset);
+          for (; __first != __last; ++__first) {
+            _Tp __next = __op_(__running, *__first);
+            *__first = std::move(__running);
+            __running = std::move(__next);
+          }
+        }
+      }
+    };
+
+    struct __release_range_fn {
+      template <class _Range, class _Tp>
+      _Range operator()(__reduce::__chunked_state<_Range, _Tp>&& __state) const {
+        return std::move(__state.__range_);
+      }
+    };
+
+    template <sender _Sender, class _MakeState, class _Init, class _Op>
+    auto __chunked_scan(
+      _Sender&& __sndr,
+      std::size_t __chunks,
+      _MakeState __make_state,
+      _Init __init,
+      _Op __op) {
+      return then(
+        bulk(
+          then(
+            bulk(
+              then((_Sender&&) __sndr, __make_state),
+              __chunks,
+              __reduce::__chunk_fn<_Op, std::identity>{__op, {}}),
+            __offsets_fn<_Init, _Op>{(_Init&&) __init, __op}),
+          __chunks,
+          __rescan_fn<_Init, _Op>{__op}),
+        __release_range_fn{});
+    }
+
+    // For use by schedulers that customize inclusive_scan and exclusive_scan in
+    // terms of their bulk.
+    template <sender _Sender, class _Op>
+    auto __chunked_inclusive_scan(_Sender&& __sndr, std::size_t __chunks, _Op __op) {
+      const std::size_t __n = __chunks == 0 ? 1 : __chunks;
+      return __scan::__chunked_scan(
+        (_Sender&&) __sndr, __n, __make_inclusive_state_fn{__n}, __no_init{}, (_Op&&) __op);
+    }
+
+    template <sender _Sender, class _Tp, class _Op>
+    auto __chunked_exclusive_scan(_Sender&& __sndr, std::size_t __chunks, _Tp __init, _Op __op) {
+      const std::size_t __n = __chunks == 0 ? 1 : __chunks;
+      return __scan::__chunked_scan(
+        (_Sender&&) __sndr,
+        __n,
+        __reduce::__make_state_fn<_Tp>{__n},
+        (_Tp&&) __init,
+        (_Op&&) __op);
+    }
+
+    struct inclusive_scan_t {
+      template <sender _Sender, __movable_value _Op = std::plus<>>
+        requires __tag_invocable_with_completion_scheduler<
+          inclusive_scan_t,
+          set_value_t,
+          _Sender,
+          _Op>
+      sender auto operator()(_Sender&& __sndr, _Op __op = {}) const
+        noexcept(nothrow_tag_invocable<
+                 inclusive_scan_t,
+                 __completion_scheduler_for<_Sender, set_value_t>,
+                 _Sender,
+                 _Op>) {
+        auto __sched = get_completion_scheduler<set_value_t>(get_env(__sndr));
+        return tag_invoke(
+          inclusive_scan_t{}, std::move(__sched), (_Sender&&) __sndr, (_Op&&) __op);
+      }
+
+      template <sender _Sender, __movable_value _Op = std::plus<>>
+        requires(!__tag_invocable_with_completion_scheduler<
+                  inclusive_scan_t,
+                  set_value_t,
+                  _Sender,
+                  _Op>)
+             && tag_invocable<inclusive_scan_t, _Sender, _Op>
+      sender auto operator()(_Sender&& __sndr, _Op __op = {}) const
+        noexcept(nothrow_tag_invocable<inclusive_scan_t, _Sender, _Op>) {
+        return tag_invoke(inclusive_scan_t{}, (_Sender&&) __sndr, (_Op&&) __op);
+      }
+
+      template <sender _Sender, __movable_value _Op = std::plus<>>
+        requires(!__tag_invocable_with_completion_scheduler<
+                  inclusive_scan_t,
+                  set_value_t,
+                  _Sender,
+                  _Op>)
+             && (!tag_invocable<inclusive_scan_t, _Sender, _Op>)
+      auto operator()(_Sender&& __sndr, _Op __op = {}) const
+        -> then_t::__sender<_Sender, __sequential_inclusive_fn<_Op>> {
+        return {(_Sender&&) __sndr, __sequential_inclusive_fn<_Op>{(_Op&&) __op}};
+      }
+
+      template <class _Op = std::plus<>>
+        requires(!sender<_Op>)
+      __binder_back<inclusive_scan_t, _Op> operator()(_Op __op = {}) const {
+        return {{}, {}, {(_Op&&) __op}};
+      }
+
+      // On a static_thread_pool: one chunk per thread. Each chunk is reduced, the partials
+      // are scanned, and each chunk is scanned again from the partial before it.
+      template <sender _Sender, class _Op>
+      friend auto tag_invoke(
+        inclusive_scan_t,
+        const static_thread_pool::scheduler& __sched,
+        _Sender&& __sndr,
+        _Op __op) {
+        return __scan::__chunked_inclusive_scan(
+          (_Sender&&) __sndr, __sched.__available_parallelism(), (_Op&&) __op);
+      }
+    };
+
+    struct exclusive_scan_t {
+      template <sender _Sender, class _Tp, __movable_value _Op = std::plus<>>
+        requires __tag_invocable_with_completion_scheduler<
+          exclusive_scan_t,
+          set_value_t,
+          _Sender,
+          _Tp,
+          _Op>
+      sender auto operator()(_Sender&& __sndr, _Tp __init, _Op __op = {}) const
+        noexcept(nothrow_tag_invocable<
+                 exclusive_scan_t,
+                 __completion_scheduler_for<_Sender, set_value_t>,
+                 _Sender,
+                 _Tp,
+                 _Op>) {
+        auto __sched = get_completion_scheduler<set_value_t>(get_env(__sndr));
+        return tag_invoke(
+          exclusive_scan_t{},
+          std::move(__sched),
+          (_Sender&&) __sndr,
+          (_Tp&&) __init,
+          (_Op&&) __op);
+      }
+
+      template <sender _Sender, class _Tp, __movable_value _Op = std::plus<>>
+        requires(!__tag_invocable_with_completion_scheduler<
+                  exclusive_scan_t,
+                  set_value_t,
+                  _Sender,
+                  _Tp,
+                  _Op>)
+             && tag_invocable<exclusive_scan_t, _Sender, _Tp, _Op>
+      sender auto operator()(_Sender&& __sndr, _Tp __init, _Op __op = {}) const
+        noexcept(nothrow_tag_invocable<exclusive_scan_t, _Sender, _Tp, _Op>) {
+        return tag_invoke(
+          exclusive_scan_t{}, (_Sender&&) __sndr, (_Tp&&) __init, (_Op&&) __op);
+      }
+
+      template <sender _Sender, class _Tp, __movable_value _Op = std::plus<>>
+        requires(!__tag_invocable_with_completion_scheduler<
+                  exclusive_scan_t,
+                  set_value_t,
+                  _Sender,
+                  _Tp,
+                  _Op>)
+             && (!tag_invocable<exclusive_scan_t, _Sender, _Tp, _Op>)
+      auto operator()(_Sender&& __sndr, _Tp __init, _Op __op = {}) const
+        -> then_t::__sender<_Sender, __sequential_exclusive_fn<_Tp, _Op>> {
+        return {
+          (_Sender&&) __sndr,
+          __sequential_exclusive_fn<_Tp, _Op>{(_Tp&&) __init, (_Op&&) __op}
+        };
+      }
+
+      template <class _Tp, class _Op = std::plus<>>
+        requires(!sender<_Tp>)
+      __binder_back<exclusive_scan_t, _Tp, _Op> operator()(_Tp __init, _Op __op = {}) const {
+        return {
+          {},
+          {},
+          {(_Tp&&) __init, (_Op&&) __op}
+        };
+      }
+
+      // On a static_thread_pool: as for inclusive_scan.
+      template <sender _Sender, class _Tp, class _Op>
+      friend auto tag_invoke(
+        exclusive_scan_t,
+        const static_thread_pool::scheduler& __sched,
+        _Sender&& __sndr,
+        _Tp __init,
+        _Op __op) {
+        return __scan::__chunked_exclusive_scan(
+          (_Sender&&) __sndr, __sched.__available_parallelism(), (_Tp&&) __init, (_Op&&) __op);
+      }
+    };
+  } // namespace __scan
+
+  using __scan::inclusive_scan_t;
+  inline constexpr inclusive_scan_t inclusive_scan{};
+
+  using __scan::exclusive_scan_t;
+  inline constexpr exclusive_scan_t exclusive_scan{};
+} // namespace exec
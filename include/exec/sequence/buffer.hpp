@@ -0,0 +1,385 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "../sequence_senders.hpp"
+#include "../__detail/__intrusive_list.hpp"
+
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+namespace exec {
+  /////////////////////////////////////////////////////////////////////////////
+  // buffer(sequence, n): the sequence of the same items, which lets the
+  // producer run up to n items ahead of the receiver. Each item is passed on
+  // to the receiver's set_next as soon as fewer than n items are in flight,
+  // and the producer may go on to the next item right away. The receiver's
+  // set_next may therefore be called from several threads at once.
+  //
+  // The operation state allocates the n slots for the next-senders of the
+  // items in flight once, when it is subscribed; nothing is allocated per
+  // item. If the receiver asks for no more items, the producer is asked to
+  // stop, and the sequence completes once the items in flight have.
+  namespace __buffer {
+    using namespace stdexec;
+
+    template <class _Slot>
+    struct __waiter : __immovable {
+      // Runs the item in the slot, or completes with set_stopped if the slot is null.
+      void (*__resume_)(__waiter*, _Slot*) noexcept;
+      __waiter* __prev_ = nullptr;
+      __waiter* __next_ = nullptr;
+    };
+
+    template <class _ReceiverId, class _Items, class _ErrorStorage>
+    struct __operation_base;
+
+    // A slot for the next-sender of an item in flight.
+    template <class _ReceiverId, class _Items, class _ErrorStorage>
+    struct __slot {
+      using _Receiver = stdexec::__t<_ReceiverId>;
+      using __owner_t = __operation_base<_ReceiverId, _Items, _ErrorStorage>;
+
+      struct __receiver {
+        using is_receiver = void;
+        __slot* __slot_;
+
+        friend void tag_invoke(set_value_t, __receiver&& __self) noexcept {
+          __self.__slot_->__completed(false);
+        }
+
+        friend void tag_invoke(set_stopped_t, __receiver&& __self) noexcept {
+          __self.__slot_->__completed(true);
+        }
+
+        friend env_of_t<_Receiver> tag_invoke(get_env_t, const __receiver& __self) noexcept {
+          return get_env(__self.__slot_->__owner_->__rcvr_);
+        }
+      };
+
+      template <class _Item>
+      using __next_op_t = connect_result_t<next_sender_of_t<_Receiver, _Item>, __receiver>;
+
+      using __next_ops_t = __mapply<__transform<__q<__next_op_t>, __nullable_variant_t>, _Items>;
+
+      __owner_t* __owner_ = nullptr;
+      __slot* __next_free_ = nullptr;
+      __next_ops_t __next_op_{};
+
+      template <class _Item>
+      void __start(_Item&& __item) {
+        auto& __next_op = __next_op_.template emplace<__next_op_t<_Item>>(__conv{[&] {
+          return connect(set_next(__owner_->__rcvr_, (_Item&&) __item), __receiver{this});
+        }});
+        start(__next_op);
+      }
+
+      void __completed(bool __stopped) noexcept {
+        __owner_t* __owner = __owner_;
+        // The following line causes the invalidation of the slot's receiver.
+        __next_op_.template emplace<0>();
+        __owner->__release(this, __stopped);
+      }
+    };
+
+    template <class _ReceiverId, class _Items, class _ErrorStorage>
+    struct __operation_base : __immovable {
+      using _Receiver = stdexec::__t<_ReceiverId>;
+      using __slot_t = __slot<_ReceiverId, _Items, _ErrorStorage>;
+      using __waiter_t = __waiter<__slot_t>;
+
+      __operation_base(_Receiver&& __rcvr, std::size_t __size)
+        : __rcvr_((_Receiver&&) __rcvr)
+        , __slots_(new __slot_t[__size]) {
+        for (std::size_t __i = 0; __i < __size; ++__i) {
+          __slots_[__i].__owner_ = this;
+          __slots_[__i].__next_free_ = __free_;
+          __free_ = &__slots_[__i];
+        }
+      }
+
+      STDEXEC_NO_UNIQUE_ADDRESS _Receiver __rcvr_;
+      std::unique_ptr<__slot_t[]> __slots_;
+      _ErrorStorage __error_{};
+
+      std::mutex __lock_;
+      __slot_t* __free_ = nullptr;
+      std::size_t __in_flight_ = 0;
+      __intrusive_list<&__waiter_t::__prev_, &__waiter_t::__next_> __waiters_;
+      // Set once the receiver asked for no more items.
+      bool __stopped_ = false;
+      // Set once the sequence completed, with set_stopped if __sequence_stopped_.
+      bool __sequence_done_ = false;
+      bool __sequence_stopped_ = false;
+
+      // Runs the waiter's item in a free slot, or queues the waiter until one is released.
+      void __acquire(__waiter_t* __waiter) noexcept {
+        __slot_t* __slot = nullptr;
+        {
+          std::unique_lock __guard{__lock_};
+          if (!__stopped_) {
+            if (__free_ == nullptr) {
+              __waiters_.push_back(__waiter);
+              return;
+            }
+            __slot = std::exchange(__free_, __free_->__next_free_);
+            ++__in_flight_;
+          }
+        }
+        __waiter->__resume_(__waiter, __slot);
+      }
+
+      void __release(__slot_t* __slot, bool __stopped) noexcept {
+        __waiter_t* __next = nullptr;
+        decltype(__waiters_) __stopped_waiters;
+        bool __done = false;
+        {
+          std::unique_lock __guard{__lock_};
+          if (__stopped && !__stopped_) {
+            __stopped_ = true;
+            __stopped_waiters = std::move(__waiters_);
+          }
+          if (!__waiters_.empty()) {
+            // Hand the slot over to the oldest waiting item.
+            __next = __waiters_.pop_front();
+          } else {
+            __slot->__next_free_ = std::exchange(__free_, __slot);
+            __done = --__in_flight_ == 0 && __sequence_done_;
+          }
+        }
+        while (!__stopped_waiters.empty()) {
+          __waiter_t* __waiter = __stopped_waiters.pop_front();
+          __waiter->__resume_(__waiter, nullptr);
+        }
+        if (__next != nullptr) {
+          __next->__resume_(__next, __slot);
+        }
+        if (__done) {
+          __complete();
+        }
+      }
+
+      void __sequence_completed(bool __stopped) noexcept {
+        bool __done = false;
+        {
+          std::unique_lock __guard{__lock_};
+          __sequence_done_ = true;
+          __sequence_stopped_ = __stopped;
+          __done = __in_flight_ == 0;
+        }
+        if (__done) {
+          __complete();
+        }
+      }
+
+      void __complete() noexcept {
+        if (__error_.__has_error()) {
+          __error_.__complete((_Receiver&&) __rcvr_);
+        } else if (__sequence_stopped_) {
+          set_stopped((_Receiver&&) __rcvr_);
+        } else {
+          set_value((_Receiver&&) __rcvr_);
+        }
+      }
+    };
+
+    template <class _ItemId, class _NextReceiverId, class _OpBase>
+    struct __next_operation : __waiter<typename _OpBase::__slot_t> {
+      using _Item = stdexec::__t<_ItemId>;
+      using _NextReceiver = stdexec::__t<_NextReceiverId>;
+      using __slot_t = typename _OpBase::__slot_t;
+
+      _OpBase* __op_;
+      _Item __item_;
+      STDEXEC_NO_UNIQUE_ADDRESS _NextReceiver __next_rcvr_;
+
+      __next_operation(_OpBase* __op, _Item&& __item, _NextReceiver&& __next_rcvr)
+        : __waiter<__slot_t>{{}, &__resume}
+        , __op_{__op}
+        , __item_((_Item&&) __item)
+        , __next_rcvr_((_NextReceiver&&) __next_rcvr) {
+      }
+
+      static void __resume(__waiter<__slot_t>* __waiter, __slot_t* __slot) noexcept {
+        auto* __self = static_cast<__next_operation*>(__waiter);
+        if (__slot == nullptr) {
+          set_stopped((_NextReceiver&&) __self->__next_rcvr_);
+          return;
+        }
+        try {
+          __slot->__start((_Item&&) __self->__item_);
+        } catch (...) {
+          __self->__op_->__error_.__store(std::current_exception());
+          __slot->__completed(true);
+          set_stopped((_NextReceiver&&) __self->__next_rcvr_);
+          return;
+        }
+        // The item is in flight; let the producer go on.
+        set_value((_NextReceiver&&) __self->__next_rcvr_);
+      }
+
+      friend void tag_invoke(start_t, __next_operation& __self) noexcept {
+        __self.__op_->__acquire(&__self);
+      }
+    };
+
+    template <class _ItemId, class _OpBase>
+    struct __next_sender {
+      using _Item = stdexec::__t<_ItemId>;
+
+      using is_sender = void;
+      using completion_signatures = stdexec::completion_signatures<set_value_t(), set_stopped_t()>;
+
+      _OpBase* __op_;
+      _Item __item_;
+
+      template <receiver_of<completion_signatures> _NextReceiver>
+      friend __next_operation<_ItemId, __x<_NextReceiver>, _OpBase>
+        tag_invoke(connect_t, __next_sender&& __self, _NextReceiver __next_rcvr) {
+        return {__self.__op_, (_Item&&) __self.__item_, (_NextReceiver&&) __next_rcvr};
+      }
+
+      friend empty_env tag_invoke(get_env_t, const __next_sender&) noexcept {
+        return {};
+      }
+    };
+
+    template <class _OpBase>
+    struct __receiver {
+      using _Receiver = typename _OpBase::_Receiver;
+
+      using is_receiver = void;
+      _OpBase* __op_;
+
+      template <sender _Item>
+      friend __next_sender<__x<__decay_t<_Item>>, _OpBase>
+        tag_invoke(set_next_t, __receiver& __self, _Item&& __item) {
+        return {__self.__op_, (_Item&&) __item};
+      }
+
+      friend void tag_invoke(set_value_t, __receiver&& __self) noexcept {
+        __self.__op_->__sequence_completed(false);
+      }
+
+      template <class _Error>
+      friend void tag_invoke(set_error_t, __receiver&& __self, _Error&& __error) noexcept {
+        __self.__op_->__error_.__store((_Error&&) __error);
+        __self.__op_->__sequence_completed(false);
+      }
+
+      friend void tag_invoke(set_stopped_t, __receiver&& __self) noexcept {
+        __self.__op_->__sequence_completed(true);
+      }
+
+      friend env_of_t<_Receiver> tag_invoke(get_env_t, const __receiver& __self) noexcept {
+        return get_env(__self.__op_->__rcvr_);
+      }
+    };
+
+    template <class _Sequence, class _Env>
+    using __completion_signatures_t = __concat_completion_signatures_t<
+      completion_signatures_of_t<_Sequence, _Env>,
+      completion_signatures<set_error_t(std::exception_ptr)>>;
+
+    template <class _CvrefSequenceId, class _ReceiverId>
+    struct __operation
+      : __operation_base<
+          _ReceiverId,
+          item_types_of_t<__cvref_t<_CvrefSequenceId>>,
+          __sequence_senders::__first_error_for_t<__completion_signatures_t<
+            __cvref_t<_CvrefSequenceId>,
+            env_of_t<stdexec::__t<_ReceiverId>>>>> {
+      using _Sequence = __cvref_t<_CvrefSequenceId>;
+      using _Receiver = stdexec::__t<_ReceiverId>;
+      using __base_t = __operation_base<
+        _ReceiverId,
+        item_types_of_t<_Sequence>,
+        __sequence_senders::__first_error_for_t<
+          __completion_signatures_t<_Sequence, env_of_t<_Receiver>>>>;
+      using __receiver_t = __receiver<__base_t>;
+
+      subscribe_result_t<_Sequence, __receiver_t> __op_;
+
+      __operation(_Sequence&& __sequence, _Receiver&& __rcvr, std::size_t __size)
+        : __base_t{(_Receiver&&) __rcvr, __size}
+        , __op_(subscribe((_Sequence&&) __sequence, __receiver_t{this})) {
+      }
+
+      friend void tag_invoke(start_t, __operation& __self) noexcept {
+        start(__self.__op_);
+      }
+    };
+
+    template <class _SequenceId>
+    struct __sequence {
+      using _Sequence = stdexec::__t<_SequenceId>;
+
+      using is_sender = void;
+      using item_types = item_types_of_t<_Sequence>;
+
+      _Sequence __sequence_;
+      std::size_t __size_;
+
+      template <__decays_to<__sequence> _Self, receiver _Receiver>
+        requires sequence_receiver_of<_Receiver, item_types>
+      friend __operation<__cvref_id<_Self, _Sequence>, __x<_Receiver>>
+        tag_invoke(subscribe_t, _Self&& __self, _Receiver __rcvr) {
+        return {((_Self&&) __self).__sequence_, (_Receiver&&) __rcvr, __self.__size_};
+      }
+
+      template <__decays_to<__sequence> _Self, class _Env>
+      friend auto tag_invoke(get_completion_signatures_t, _Self&&, _Env)
+        -> dependent_completion_signatures<_Env>;
+
+      template <__decays_to<__sequence> _Self, class _Env>
+      friend auto tag_invoke(get_completion_signatures_t, _Self&&, _Env)
+        -> __completion_signatures_t<__copy_cvref_t<_Self, _Sequence>, _Env>
+        requires true;
+
+      friend empty_env tag_invoke(get_env_t, const __sequence&) noexcept {
+        return {};
+      }
+    };
+
+    struct buffer_t {
+      template <sequence_sender _Sequence>
+      __sequence<__x<__decay_t<_Sequence>>>
+        operator()(_Sequence&& __sequence, std::size_t __size) const {
+        __check_size(__size);
+        return {(_Sequence&&) __sequence, __size};
+      }
+
+      __binder_back<buffer_t, std::size_t> operator()(std::size_t __size) const {
+        __check_size(__size);
+        return {{}, {}, {__size}};
+      }
+
+     private:
+      // Without a slot no item could ever be started.
+      static void __check_size(std::size_t __size) {
+        if (__size == 0) {
+          throw std::invalid_argument("buffer: size must be positive");
+        }
+      }
+    };
+  } // namespace __buffer
+
+  using __buffer::buffer_t;
+  inline constexpr buffer_t buffer{};
+} // namespace exec
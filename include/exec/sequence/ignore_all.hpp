@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "../sequence_senders.hpp"
+
+namespace exec {
+  /////////////////////////////////////////////////////////////////////////////
+  // ignore_all(sequence): a sender that runs each item of the sequence,
+  // discards the values the items send, and completes once the sequence has.
+  //
+  //   ex::sync_wait(exec::iterate(values) | exec::transform_each(ex::then(log)) |
+  //                 exec::ignore_all());
+  //
+  // When an item fails, the sequence is asked to stop, and the sender
+  // completes with the item's error once the sequence has completed.
+  // Otherwise it completes as the sequence does.
+  namespace __ignore_all {
+    using namespace stdexec;
+
+    template <class... _Errors>
+    using __as_errors = completion_signatures<set_error_t(_Errors)...>;
+
+    template <class _Sender, class _Env>
+    using __error_signatures_t = error_types_of_t<_Sender, _Env, __as_errors>;
+
+    template <class... _Items>
+    struct __item_errors {
+      template <class _Env>
+      using __f = __concat_completion_signatures_t<__error_signatures_t<_Items, _Env>...>;
+    };
+
+    template <class _Sequence, class _Env>
+    using __completion_signatures_t = __concat_completion_signatures_t<
+      completion_signatures<set_value_t(), set_stopped_t()>,
+      __error_signatures_t<_Sequence, _Env>,
+      __minvoke<__mapply<__q<__item_errors>, item_types_of_t<_Sequence>>, _Env>>;
+
+    template <class _Sequence, class _Receiver>
+    using __error_storage_t = __sequence_senders::__first_error_for_t<
+      __completion_signatures_t<_Sequence, env_of_t<_Receiver>>>;
+
+    template <class _ReceiverId, class _ErrorStorage>
+    struct __operation_base : __immovable {
+      using _Receiver = stdexec::__t<_ReceiverId>;
+
+      STDEXEC_NO_UNIQUE_ADDRESS _Receiver __rcvr_;
+      _ErrorStorage __item_error_{};
+
+      // Completes the receiver with the error of an item if there was one, and as the
+      // sequence completed otherwise.
+      template <class _Tag, class... _Args>
+      void __complete(_Tag __tag, _Args&&... __args) noexcept {
+        if (__item_error_.__has_error()) {
+          __item_error_.__complete((_Receiver&&) __rcvr_);
+        } else {
+          __tag((_Receiver&&) __rcvr_, (_Args&&) __args...);
+        }
+      }
+    };
+
+    template <class _ItemId, class _NextReceiverId, class _OpBase>
+    struct __item_operation {
+      using _Item = stdexec::__t<_ItemId>;
+      using _NextReceiver = stdexec::__t<_NextReceiverId>;
+
+      struct __receiver {
+        using is_receiver = void;
+        __item_operation* __op_;
+
+        template <class... _Values>
+        friend void tag_invoke(set_value_t, __receiver&& __self, _Values&&...) noexcept {
+          set_value((_NextReceiver&&) __self.__op_->__next_rcvr_);
+        }
+
+        template <class _Error>
+        friend void tag_invoke(set_error_t, __receiver&& __self, _Error&& __error) noexcept {
+          __self.__op_->__op_->__item_error_.__store((_Error&&) __error);
+          set_stopped((_NextReceiver&&) __self.__op_->__next_rcvr_);
+        }
+
+        friend void tag_invoke(set_stopped_t, __receiver&& __self) noexcept {
+          set_stopped((_NextReceiver&&) __self.__op_->__next_rcvr_);
+        }
+
+        friend env_of_t<typename _OpBase::_Receiver>
+          tag_invoke(get_env_t, const __receiver& __self) noexcept {
+          return get_env(__self.__op_->__op_->__rcvr_);
+        }
+      };
+
+      _OpBase* __op_;
+      STDEXEC_NO_UNIQUE_ADDRESS _NextReceiver __next_rcvr_;
+      connect_result_t<_Item, __receiver> __item_op_;
+
+      __item_operation(_OpBase* __op, _Item&& __item, _NextReceiver&& __next_rcvr)
+        : __op_{__op}
+        , __next_rcvr_((_NextReceiver&&) __next_rcvr)
+        , __item_op_(connect((_Item&&) __item, __receiver{this})) {
+      }
+
+      friend void tag_invoke(start_t, __item_operation& __self) noexcept {
+        start(__self.__item_op_);
+      }
+    };
+
+    // The next-sender for an item: runs the item and then asks for the next one.
+    template <class _ItemId, class _OpBase>
+    struct __item_sender {
+      using _Item = stdexec::__t<_ItemId>;
+
+      using is_sender = void;
+      using completion_signatures = stdexec::completion_signatures<set_value_t(), set_stopped_t()>;
+
+      _OpBase* __op_;
+      _Item __item_;
+
+      template <receiver_of<completion_signatures> _NextReceiver>
+      friend __item_operation<_ItemId, __x<_NextReceiver>, _OpBase>
+        tag_invoke(connect_t, __item_sender&& __self, _NextReceiver __next_rcvr) {
+        return {__self.__op_, (_Item&&) __self.__item_, (_NextReceiver&&) __next_rcvr};
+      }
+
+      friend empty_env tag_invoke(get_env_t, const __item_sender&) noexcept {
+        return {};
+      }
+    };
+
+    template <class _OpBase>
+    struct __receiver {
+      using is_receiver = void;
+      _OpBase* __op_;
+
+      template <sender _Item>
+      friend __item_sender<__x<__decay_t<_Item>>, _OpBase>
+        tag_invoke(set_next_t, __receiver& __self, _Item&& __item) {
+        return {__self.__op_, (_Item&&) __item};
+      }
+
+      template <__completion_tag _Tag, class... _Args>
+      friend void tag_invoke(_Tag __tag, __receiver&& __self, _Args&&... __args) noexcept {
+        __self.__op_->__complete(__tag, (_Args&&) __args...);
+      }
+
+      friend env_of_t<typename _OpBase::_Receiver>
+        tag_invoke(get_env_t, const __receiver& __self) noexcept {
+        return get_env(__self.__op_->__rcvr_);
+      }
+    };
+
+    template <class _CvrefSequenceId, class _ReceiverId>
+    struct __operation
+      : __operation_base<
+          _ReceiverId,
+          __error_storage_t<__cvref_t<_CvrefSequenceId>, stdexec::__t<_ReceiverId>>> {
+      using _Sequence = __cvref_t<_CvrefSequenceId>;
+      using _Receiver = stdexec::__t<_ReceiverId>;
+      using __base_t =
+        __operation_base<_ReceiverId, __error_storage_t<_Sequence, _Receiver>>;
+      using __receiver_t = __receiver<__base_t>;
+
+      subscribe_result_t<_Sequence, __receiver_t> __op_;
+
+      __operation(_Sequence&& __sequence, _Receiver&& __rcvr)
+        : __base_t{{}, (_Receiver&&) __rcvr}
+        , __op_(subscribe((_Sequence&&) __sequence, __receiver_t{this})) {
+      }
+
+      friend void tag_invoke(start_t, __operation& __self) noexcept {
+        start(__self.__op_);
+      }
+    };
+
+    template <class _SequenceId>
+    struct __sender {
+      using _Sequence = stdexec::__t<_SequenceId>;
+
+      using is_sender = void;
+
+      _Sequence __sequence_;
+
+      template <__decays_to<__sender> _Self, receiver _Receiver>
+        requires receiver_of<
+          _Receiver,
+          __completion_signatures_t<__copy_cvref_t<_Self, _Sequence>, env_of_t<_Receiver>>>
+      friend __operation<__cvref_id<_Self, _Sequence>, __x<_Receiver>>
+        tag_invoke(connect_t, _Self&& __self, _Receiver __rcvr) {
+        return {((_Self&&) __self).__sequence_, (_Receiver&&) __rcvr};
+      }
+
+      template <__decays_to<__sender> _Self, class _Env>
+      friend auto tag_invoke(get_completion_signatures_t, _Self&&, _Env)
+        -> dependent_completion_signatures<_Env>;
+
+      template <__decays_to<__sender> _Self, class _Env>
+      friend auto tag_invoke(get_completion_signatures_t, _Self&&, _Env)
+        -> __completion_signatures_t<__copy_cvref_t<_Self, _Sequence>, _Env>
+        requires true;
+
+      friend empty_env tag_invoke(get_env_t, const __sender&) noexcept {
+        return {};
+      }
+    };
+
+    struct ignore_all_t {
+      template <sequence_sender _Sequence>
+      __sender<__x<__decay_t<_Sequence>>> operator()(_Sequence&& __sequence) const {
+        return {(_Sequence&&) __sequence};
+      }
+
+      constexpr __binder_back<ignore_all_t> operator()() const noexcept {
+        return {{}, {}, {}};
+      }
+    };
+  } // namespace __ignore_all
+
+  using __ignore_all::ignore_all_t;
+  inline constexpr ignore_all_t ignore_all{};
+} // namespace exec
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "../sequence_senders.hpp"
+#include "../__detail/__loop_frame.hpp"
+#include "../__detail/__manual_lifetime.hpp"
+
+#include <exception>
+#include <iterator>
+#include <ranges>
+
+namespace exec {
+  /////////////////////////////////////////////////////////////////////////////
+  // iterate(range): a sequence with an item for each element of the range,
+  // in order. Each item sends a reference to its element. An lvalue range is
+  // referred to and must outlive the operation; an rvalue range is moved
+  // into the sequence.
+  //
+  // The operation state reuses a single slot for the next-sender of each
+  // item, and checks the receiver's stop token before each item.
+  namespace __iterate {
+    using namespace stdexec;
+
+    template <class _Iterator, class _ReceiverId>
+    struct __item_operation {
+      using _Receiver = stdexec::__t<_ReceiverId>;
+
+      _Iterator __it_;
+      STDEXEC_NO_UNIQUE_ADDRESS _Receiver __rcvr_;
+
+      friend void tag_invoke(start_t, __item_operation& __self) noexcept {
+        if constexpr (noexcept(*__self.__it_)) {
+          set_value((_Receiver&&) __self.__rcvr_, *__self.__it_);
+        } else {
+          try {
+            set_value((_Receiver&&) __self.__rcvr_, *__self.__it_);
+          } catch (...) {
+            set_error((_Receiver&&) __self.__rcvr_, std::current_exception());
+          }
+        }
+      }
+    };
+
+    template <class _Iterator>
+    struct __item_sender {
+      using is_sender = void;
+      using __reference_t = std::iter_reference_t<_Iterator>;
+      using completion_signatures = __if_c<
+        noexcept(*__declval<_Iterator&>()),
+        stdexec::completion_signatures<set_value_t(__reference_t)>,
+        stdexec::completion_signatures<
+          set_value_t(__reference_t),
+          set_error_t(std::exception_ptr)>>;
+
+      _Iterator __it_;
+
+      template <receiver_of<completion_signatures> _Receiver>
+      friend __item_operation<_Iterator, __x<_Receiver>>
+        tag_invoke(connect_t, __item_sender __self, _Receiver __rcvr) noexcept(
+          __nothrow_decay_copyable<_Iterator> && __nothrow_decay_copyable<_Receiver>) {
+        return {(_Iterator&&) __self.__it_, (_Receiver&&) __rcvr};
+      }
+
+      friend empty_env tag_invoke(get_env_t, const __item_sender&) noexcept {
+        return {};
+      }
+    };
+
+    template <class _ViewId, class _ReceiverId>
+    struct __operation : __immovable {
+      using _View = stdexec::__t<_ViewId>;
+      using _Receiver = stdexec::__t<_ReceiverId>;
+      using _Iterator = std::ranges::iterator_t<_View>;
+      using __item_t = __item_sender<_Iterator>;
+
+      struct __next_receiver {
+        using is_receiver = void;
+        __operation* __op_;
+
+        friend void tag_invoke(set_value_t, __next_receiver&& __self) noexcept {
+          __operation* __op = __self.__op_;
+          // The following line causes the invalidation of __self.
+          __op->__next_op_.__destruct();
+          ++__op->__it_;
+          __op->__next();
+        }
+
+        friend void tag_invoke(set_stopped_t, __next_receiver&& __self) noexcept {
+          __operation* __op = __self.__op_;
+          __op->__next_op_.__destruct();
+          set_stopped((_Receiver&&) __op->__rcvr_);
+        }
+
+        friend env_of_t<_Receiver> tag_invoke(get_env_t, const __next_receiver& __self) noexcept {
+          return get_env(__self.__op_->__rcvr_);
+        }
+      };
+
+      using __next_op_t = connect_result_t<next_sender_of_t<_Receiver, __item_t>, __next_receiver>;
+
+      _View __view_;
+      _Iterator __it_;
+      STDEXEC_NO_UNIQUE_ADDRESS _Receiver __rcvr_;
+      __manual_lifetime<__next_op_t> __next_op_;
+
+      template <class _View2>
+      __operation(_View2&& __view, _Receiver&& __rcvr)
+        : __view_((_View2&&) __view)
+        , __it_(std::ranges::begin(__view_))
+        , __rcvr_((_Receiver&&) __rcvr) {
+      }
+
+      bool __stop_requested() const noexcept {
+        if constexpr (unstoppable_token<stop_token_of_t<env_of_t<_Receiver>>>) {
+          return false;
+        } else {
+          return get_stop_token(get_env(__rcvr_)).stop_requested();
+        }
+      }
+
+      // Produces items while their next-senders complete synchronously from within start(),
+      // instead of nesting on the stack (see __loop_frame).
+      void __loop() noexcept {
+        __loop_frame __frame{this};
+        do {
+          if (__it_ == std::ranges::end(__view_)) {
+            set_value((_Receiver&&) __rcvr_);
+            break;
+          }
+          if (__stop_requested()) {
+            set_stopped((_Receiver&&) __rcvr_);
+            break;
+          }
+          try {
+            auto& __next_op = __next_op_.__construct_with([&] {
+              return connect(set_next(__rcvr_, __item_t{__it_}), __next_receiver{this});
+            });
+            start(__next_op);
+          } catch (...) {
+            set_error((_Receiver&&) __rcvr_, std::current_exception());
+            break;
+          }
+        } while (__frame.__again());
+      }
+
+      // Called after the next-sender of an item completed with set_value.
+      void __next() noexcept {
+        if (!__loop_frame::__resume(this)) {
+          __loop();
+        }
+      }
+
+      friend void tag_invoke(start_t, __operation& __self) noexcept {
+        __self.__loop();
+      }
+    };
+
+    template <class _ViewId>
+    struct __sequence {
+      using _View = stdexec::__t<_ViewId>;
+      using __item_t = __item_sender<std::ranges::iterator_t<_View>>;
+
+      using is_sender = void;
+      using item_types = exec::item_types<__item_t>;
+      using completion_signatures = stdexec::completion_signatures<
+        set_value_t(),
+        set_error_t(std::exception_ptr),
+        set_stopped_t()>;
+
+      _View __view_;
+
+      template <__decays_to<__sequence> _Self, sequence_receiver_of<item_types> _Receiver>
+        requires constructible_from<_View, __copy_cvref_t<_Self, _View>>
+      friend __operation<_ViewId, __x<_Receiver>>
+        tag_invoke(subscribe_t, _Self&& __self, _Receiver __rcvr) {
+        return {((_Self&&) __self).__view_, (_Receiver&&) __rcvr};
+      }
+
+      friend empty_env tag_invoke(get_env_t, const __sequence&) noexcept {
+        return {};
+      }
+    };
+
+    struct iterate_t {
+      template <std::ranges::input_range _Range>
+        requires std::ranges::viewable_range<_Range>
+      __sequence<__x<std::views::all_t<_Range>>> operator()(_Range&& __range) const {
+        return {std::views::all((_Range&&) __range)};
+      }
+    };
+  } // namespace __iterate
+
+  using __iterate::iterate_t;
+  inline constexpr iterate_t iterate{};
+} // namespace exec
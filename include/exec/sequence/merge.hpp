@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "../sequence_senders.hpp"
+
+#include <optional>
+#include <tuple>
+#include <utility>
+
+namespace exec {
+  /////////////////////////////////////////////////////////////////////////////
+  // merge(sequences...): the sequence of the items of all the sequences, which
+  // run concurrently. The receiver's set_next may therefore be called from
+  // several threads at once.
+  //
+  // The merged sequence completes once all the sequences have. If one of them
+  // fails or stops, the others are asked to stop, and the merged sequence
+  // completes with the first error, or with set_stopped.
+  namespace __merge {
+    using namespace stdexec;
+
+    struct __on_stop_requested {
+      in_place_stop_source& __stop_source_;
+
+      void operator()() noexcept {
+        __stop_source_.request_stop();
+      }
+    };
+
+    template <class _BaseEnv>
+    using __env_t = __make_env_t<_BaseEnv, __with<get_stop_token_t, in_place_stop_token>>;
+
+    template <class... _Errors>
+    using __as_errors = completion_signatures<set_error_t(_Errors)...>;
+
+    template <class _Env, class... _Sequences>
+    using __completion_signatures_t = __concat_completion_signatures_t<
+      completion_signatures<set_value_t(), set_stopped_t()>,
+      error_types_of_t<_Sequences, __env_t<_Env>, __as_errors>...>;
+
+    template <class _ReceiverId, class _ErrorStorage>
+    struct __operation_base : __immovable {
+      using _Receiver = stdexec::__t<_ReceiverId>;
+      using __stop_token_t = stop_token_of_t<env_of_t<_Receiver>&>;
+      using __on_stop_t =
+        std::optional<typename __stop_token_t::template callback_type<__on_stop_requested>>;
+
+      __operation_base(_Receiver&& __rcvr, int __count)
+        : __rcvr_((_Receiver&&) __rcvr)
+        , __count_{__count} {
+      }
+
+      STDEXEC_NO_UNIQUE_ADDRESS _Receiver __rcvr_;
+      in_place_stop_source __stop_source_{};
+      __on_stop_t __on_stop_{};
+      std::atomic<int> __count_;
+      std::atomic<bool> __stopped_{false};
+      _ErrorStorage __error_{};
+
+      void __request_stop() noexcept {
+        __stop_source_.request_stop();
+      }
+
+      // Called once by each sequence when it completes. The last one completes the receiver.
+      void __sequence_completed() noexcept {
+        if (__count_.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+          return;
+        }
+        __on_stop_.reset();
+        if (__error_.__has_error()) {
+          __error_.__complete((_Receiver&&) __rcvr_);
+        } else if (
+          __stopped_.load(std::memory_order_relaxed)
+          || get_stop_token(get_env(__rcvr_)).stop_requested()) {
+          set_stopped((_Receiver&&) __rcvr_);
+        } else {
+          set_value((_Receiver&&) __rcvr_);
+        }
+      }
+    };
+
+    template <class _OpBase>
+    struct __receiver {
+      using _Receiver = typename _OpBase::_Receiver;
+
+      using is_receiver = void;
+      _OpBase* __op_;
+
+      template <sender _Item>
+        requires __callable<set_next_t, _Receiver&, _Item>
+      friend next_sender_of_t<_Receiver, _Item>
+        tag_invoke(set_next_t, __receiver& __self, _Item&& __item) {
+        return set_next(__self.__op_->__rcvr_, (_Item&&) __item);
+      }
+
+      friend void tag_invoke(set_value_t, __receiver&& __self) noexcept {
+        __self.__op_->__sequence_completed();
+      }
+
+      template <class _Error>
+      friend void tag_invoke(set_error_t, __receiver&& __self, _Error&& __error) noexcept {
+        __self.__op_->__error_.__store((_Error&&) __error);
+        __self.__op_->__request_stop();
+        __self.__op_->__sequence_completed();
+      }
+
+      friend void tag_invoke(set_stopped_t, __receiver&& __self) noexcept {
+        __self.__op_->__stopped_.store(true, std::memory_order_relaxed);
+        __self.__op_->__request_stop();
+        __self.__op_->__sequence_completed();
+      }
+
+      friend __env_t<env_of_t<_Receiver>> tag_invoke(get_env_t, const __receiver& __self) noexcept {
+        return __make_env(
+          get_env(__self.__op_->__rcvr_),
+          __with_(get_stop_token, __self.__op_->__stop_source_.get_token()));
+      }
+    };
+
+    template <class _ReceiverId, class... _CvrefSequenceIds>
+    struct __operation
+      : __operation_base<
+          _ReceiverId,
+          __sequence_senders::__first_error_for_t<__completion_signatures_t<
+            env_of_t<stdexec::__t<_ReceiverId>>,
+            __cvref_t<_CvrefSequenceIds>...>>> {
+      using _Receiver = stdexec::__t<_ReceiverId>;
+      using __base_t = __operation_base<
+        _ReceiverId,
+        __sequence_senders::__first_error_for_t<
+          __completion_signatures_t<env_of_t<_Receiver>, __cvref_t<_CvrefSequenceIds>...>>>;
+      using __receiver_t = __receiver<__base_t>;
+
+      std::tuple<subscribe_result_t<__cvref_t<_CvrefSequenceIds>, __receiver_t>...> __ops_;
+
+      template <class _SequenceTuple>
+      __operation(_SequenceTuple&& __sequences, _Receiver&& __rcvr)
+        : __operation(
+          (_SequenceTuple&&) __sequences,
+          (_Receiver&&) __rcvr,
+          std::index_sequence_for<_CvrefSequenceIds...>{}) {
+      }
+
+      template <class _SequenceTuple, std::size_t... _Is>
+      __operation(_SequenceTuple&& __sequences, _Receiver&& __rcvr, std::index_sequence<_Is...>)
+        : __base_t{(_Receiver&&) __rcvr, static_cast<int>(sizeof...(_CvrefSequenceIds))}
+        , __ops_{__conv{[&__sequences, this] {
+          return subscribe(
+            std::get<_Is>((_SequenceTuple&&) __sequences),
+            __receiver_t{static_cast<__base_t*>(this)});
+        }}...} {
+      }
+
+      friend void tag_invoke(start_t, __operation& __self) noexcept {
+        __self.__on_stop_.emplace(
+          get_stop_token(get_env(__self.__rcvr_)), __on_stop_requested{__self.__stop_source_});
+        if (__self.__stop_source_.stop_requested()) {
+          __self.__on_stop_.reset();
+          set_stopped((_Receiver&&) __self.__rcvr_);
+        } else {
+          // The last sequence to complete may destroy *this.
+          std::apply([](auto&... __ops) { (start(__ops), ...); }, __self.__ops_);
+        }
+      }
+    };
+
+    template <class... _SequenceIds>
+    struct __sequence {
+      using is_sender = void;
+      using item_types = __minvoke<
+        __mconcat<__munique<__q<exec::item_types>>>,
+        item_types_of_t<stdexec::__t<_SequenceIds>>...>;
+
+      std::tuple<stdexec::__t<_SequenceIds>...> __sequences_;
+
+      template <class _Self, class _Receiver>
+      using __operation_t =
+        __operation<__x<_Receiver>, __cvref_id<_Self, stdexec::__t<_SequenceIds>>...>;
+
+      template <__decays_to<__sequence> _Self, receiver _Receiver>
+        requires sequence_receiver_of<_Receiver, item_types>
+      friend __operation_t<_Self, _Receiver>
+        tag_invoke(subscribe_t, _Self&& __self, _Receiver __rcvr) {
+        return {((_Self&&) __self).__sequences_, (_Receiver&&) __rcvr};
+      }
+
+      template <__decays_to<__sequence> _Self, class _Env>
+      friend auto tag_invoke(get_completion_signatures_t, _Self&&, _Env)
+        -> dependent_completion_signatures<_Env>;
+
+      template <__decays_to<__sequence> _Self, class _Env>
+      friend auto tag_invoke(get_completion_signatures_t, _Self&&, _Env)
+        -> __completion_signatures_t<_Env, __copy_cvref_t<_Self, stdexec::__t<_SequenceIds>>...>
+        requires true;
+
+      friend empty_env tag_invoke(get_env_t, const __sequence&) noexcept {
+        return {};
+      }
+    };
+
+    struct merge_t {
+      template <sequence_sender... _Sequences>
+        requires(sizeof...(_Sequences) != 0)
+      __sequence<__x<__decay_t<_Sequences>>...> operator()(_Sequences&&... __sequences) const {
+        return {{(_Sequences&&) __sequences...}};
+      }
+    };
+  } // namespace __merge
+
+  using __merge::merge_t;
+  inline constexpr merge_t merge{};
+} // namespace exec
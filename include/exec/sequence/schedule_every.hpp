@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "../sequence_senders.hpp"
+#include "../timed_scheduler.hpp"
+#include "../__detail/__loop_frame.hpp"
+#include "../__detail/__manual_lifetime.hpp"
+
+#include <cstddef>
+#include <exception>
+#include <stdexcept>
+
+namespace exec {
+  /////////////////////////////////////////////////////////////////////////////
+  // schedule_every(scheduler, period): a sequence with an item for each tick
+  // of a periodic timer on a timed scheduler. The sequence goes on until the
+  // receiver wants no more items or stop is requested.
+  //
+  // The deadlines are start + k * period, where start is now(scheduler) when
+  // the operation is started, so the ticks do not drift however long the
+  // items take. Each item sends the deadline of its tick and the number of
+  // ticks missed since the previous item: a deadline that passed while the
+  // previous item was still running is skipped rather than produced late, so
+  // a slow receiver does not get a burst of ticks.
+  //
+  // The operation state reuses a single slot for the timer operation and a
+  // single slot for the next-sender of each item.
+  namespace __schedule_every {
+    using namespace stdexec;
+
+    template <class _TimePoint, class _ReceiverId>
+    struct __tick_operation {
+      using _Receiver = stdexec::__t<_ReceiverId>;
+
+      _TimePoint __deadline_;
+      std::size_t __missed_;
+      STDEXEC_NO_UNIQUE_ADDRESS _Receiver __rcvr_;
+
+      friend void tag_invoke(start_t, __tick_operation& __self) noexcept {
+        set_value(
+          (_Receiver&&) __self.__rcvr_,
+          (_TimePoint&&) __self.__deadline_,
+          (std::size_t&&) __self.__missed_);
+      }
+    };
+
+    template <class _TimePoint>
+    struct __tick_sender {
+      using is_sender = void;
+      using completion_signatures =
+        stdexec::completion_signatures<set_value_t(_TimePoint, std::size_t)>;
+
+      _TimePoint __deadline_;
+      std::size_t __missed_;
+
+      template <receiver_of<completion_signatures> _Receiver>
+      friend __tick_operation<_TimePoint, __x<_Receiver>>
+        tag_invoke(connect_t, __tick_sender __self, _Receiver __rcvr) noexcept(
+          __nothrow_decay_copyable<_Receiver>) {
+        return {__self.__deadline_, __self.__missed_, (_Receiver&&) __rcvr};
+      }
+
+      friend empty_env tag_invoke(get_env_t, const __tick_sender&) noexcept {
+        return {};
+      }
+    };
+
+    template <class... _Errors>
+    using __as_errors = completion_signatures<set_error_t(_Errors)...>;
+
+    template <class _Scheduler, class _Env>
+    using __completion_signatures_t = __concat_completion_signatures_t<
+      completion_signatures<set_error_t(std::exception_ptr), set_stopped_t()>,
+      error_types_of_t<schedule_at_result_t<_Scheduler&>, _Env, __as_errors>>;
+
+    template <class _SchedulerId, class _ReceiverId>
+    struct __operation : __immovable {
+      using _Scheduler = stdexec::__t<_SchedulerId>;
+      using _Receiver = stdexec::__t<_ReceiverId>;
+      using __time_point_t = time_point_of_t<_Scheduler&>;
+      using __duration_t = duration_of_t<_Scheduler&>;
+      using __tick_t = __tick_sender<__time_point_t>;
+
+      struct __timer_receiver {
+        using is_receiver = void;
+        __operation* __op_;
+
+        friend void tag_invoke(set_value_t, __timer_receiver&& __self) noexcept {
+          __operation* __op = __self.__op_;
+          // The following line causes the invalidation of __self.
+          __op->__timer_op_.__destruct();
+          __op->__tick();
+        }
+
+        template <class _Error>
+        friend void tag_invoke(set_error_t, __timer_receiver&& __self, _Error&& __error) noexcept {
+          __operation* __op = __self.__op_;
+          __decay_t<_Error> __err = (_Error&&) __error;
+          __op->__timer_op_.__destruct();
+          set_error((_Receiver&&) __op->__rcvr_, (__decay_t<_Error>&&) __err);
+        }
+
+        friend void tag_invoke(set_stopped_t, __timer_receiver&& __self) noexcept {
+          __operation* __op = __self.__op_;
+          __op->__timer_op_.__destruct();
+          set_stopped((_Receiver&&) __op->__rcvr_);
+        }
+
+        friend env_of_t<_Receiver> tag_invoke(get_env_t, const __timer_receiver& __self) noexcept {
+          return get_env(__self.__op_->__rcvr_);
+        }
+      };
+
+      struct __next_receiver {
+        using is_receiver = void;
+        __operation* __op_;
+
+        friend void tag_invoke(set_value_t, __next_receiver&& __self) noexcept {
+          __operation* __op = __self.__op_;
+          __op->__next_op_.__destruct();
+          __op->__next();
+        }
+
+        friend void tag_invoke(set_stopped_t, __next_receiver&& __self) noexcept {
+          __operation* __op = __self.__op_;
+          __op->__next_op_.__destruct();
+          set_stopped((_Receiver&&) __op->__rcvr_);
+        }
+
+        friend env_of_t<_Receiver> tag_invoke(get_env_t, const __next_receiver& __self) noexcept {
+          return get_env(__self.__op_->__rcvr_);
+        }
+      };
+
+      using __timer_op_t = connect_result_t<schedule_at_result_t<_Scheduler&>, __timer_receiver>;
+      using __next_op_t = connect_result_t<next_sender_of_t<_Receiver, __tick_t>, __next_receiver>;
+
+      _Scheduler __sched_;
+      __duration_t __period_;
+      STDEXEC_NO_UNIQUE_ADDRESS _Receiver __rcvr_;
+      __time_point_t __deadline_{};
+      std::size_t __missed_{0};
+      __manual_lifetime<__timer_op_t> __timer_op_;
+      __manual_lifetime<__next_op_t> __next_op_;
+
+      __operation(_Scheduler __sched, __duration_t __period, _Receiver&& __rcvr)
+        : __sched_((_Scheduler&&) __sched)
+        , __period_(__period)
+        , __rcvr_((_Receiver&&) __rcvr) {
+      }
+
+      bool __stop_requested() const noexcept {
+        if constexpr (unstoppable_token<stop_token_of_t<env_of_t<_Receiver>>>) {
+          return false;
+        } else {
+          return get_stop_token(get_env(__rcvr_)).stop_requested();
+        }
+      }
+
+      // Arms the timer for __deadline_, again in the same loop while the timer and the
+      // next-sender of the item complete synchronously (see __loop_frame).
+      void __loop() noexcept {
+        __loop_frame __frame{this};
+        do {
+          if (__stop_requested()) {
+            set_stopped((_Receiver&&) __rcvr_);
+            break;
+          }
+          try {
+            auto& __timer_op = __timer_op_.__construct_with([&] {
+              return connect(schedule_at(__sched_, __deadline_), __timer_receiver{this});
+            });
+            start(__timer_op);
+          } catch (...) {
+            set_error((_Receiver&&) __rcvr_, std::current_exception());
+            break;
+          }
+        } while (__frame.__again());
+      }
+
+      // Called when the timer fires: produces the item of the current tick.
+      void __tick() noexcept {
+        try {
+          auto& __next_op = __next_op_.__construct_with([&] {
+            return connect(
+              set_next(__rcvr_, __tick_t{__deadline_, std::exchange(__missed_, 0)}),
+              __next_receiver{this});
+          });
+          start(__next_op);
+        } catch (...) {
+          set_error((_Receiver&&) __rcvr_, std::current_exception());
+        }
+      }
+
+      // Called after the next-sender of an item completed with set_value. The next deadline
+      // is the first one that has not passed yet; the ones skipped are counted as missed.
+      void __next() noexcept {
+        __deadline_ += __period_;
+        __time_point_t __now = now(__sched_);
+        if (!(__now < __deadline_)) {
+          auto __behind = (__now - __deadline_) / __period_ + 1;
+          __missed_ += static_cast<std::size_t>(__behind);
+          __deadline_ += __behind * __period_;
+        }
+        if (!__loop_frame::__resume(this)) {
+          __loop();
+        }
+      }
+
+      friend void tag_invoke(start_t, __operation& __self) noexcept {
+        __self.__deadline_ = now(__self.__sched_) + __self.__period_;
+        __self.__loop();
+      }
+    };
+
+    template <class _SchedulerId>
+    struct __sequence {
+      using _Scheduler = stdexec::__t<_SchedulerId>;
+
+      using is_sender = void;
+      using item_types = exec::item_types<__tick_sender<time_point_of_t<_Scheduler&>>>;
+
+      _Scheduler __sched_;
+      duration_of_t<_Scheduler&> __period_;
+
+      template <__decays_to<__sequence> _Self, sequence_receiver_of<item_types> _Receiver>
+      friend __operation<_SchedulerId, __x<_Receiver>>
+        tag_invoke(subscribe_t, _Self&& __self, _Receiver __rcvr) {
+        return {((_Self&&) __self).__sched_, __self.__period_, (_Receiver&&) __rcvr};
+      }
+
+      template <__decays_to<__sequence> _Self, class _Env>
+      friend auto tag_invoke(get_completion_signatures_t, _Self&&, _Env)
+        -> dependent_completion_signatures<_Env>;
+
+      template <__decays_to<__sequence> _Self, class _Env>
+      friend auto tag_invoke(get_completion_signatures_t, _Self&&, _Env)
+        -> __completion_signatures_t<_Scheduler, _Env>
+        requires true;
+
+      friend empty_env tag_invoke(get_env_t, const __sequence&) noexcept {
+        return {};
+      }
+    };
+
+    struct schedule_every_t {
+      template <timed_scheduler _Scheduler>
+      __sequence<__x<__decay_t<_Scheduler>>>
+        operator()(_Scheduler&& __sched, duration_of_t<_Scheduler> __period) const {
+        // The deadlines have to move forward, and the catching up divides by the period.
+        if (!(__period > duration_of_t<_Scheduler>::zero())) {
+          throw std::invalid_argument("schedule_every: period must be positive");
+        }
+        return {(_Scheduler&&) __sched, __period};
+      }
+    };
+  } // namespace __schedule_every
+
+  using __schedule_every::schedule_every_t;
+  inline constexpr schedule_every_t schedule_every{};
+} // namespace exec
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "../sequence_senders.hpp"
+
+namespace exec {
+  /////////////////////////////////////////////////////////////////////////////
+  // transform_each(sequence, adaptor): the sequence whose items are
+  // adaptor(item) for the items of sequence, where adaptor is a sender
+  // adaptor such as then(f) or let_value(f).
+  //
+  //   auto squares = exec::iterate(values)
+  //                | exec::transform_each(ex::then([](int i) { return i * i; }));
+  //
+  // The adapted item is passed on to the receiver's set_next as is, so the
+  // sequence adds no state per item.
+  namespace __transform_each {
+    using namespace stdexec;
+
+    template <class _ReceiverId, class _Adaptor>
+    struct __operation_base : __immovable {
+      using _Receiver = stdexec::__t<_ReceiverId>;
+
+      STDEXEC_NO_UNIQUE_ADDRESS _Receiver __rcvr_;
+      STDEXEC_NO_UNIQUE_ADDRESS _Adaptor __adaptor_;
+    };
+
+    template <class _ReceiverId, class _Adaptor>
+    struct __receiver {
+      using _Receiver = stdexec::__t<_ReceiverId>;
+
+      using is_receiver = void;
+      __operation_base<_ReceiverId, _Adaptor>* __op_;
+
+      template <sender _Item>
+        requires __callable<_Adaptor&, _Item>
+              && __callable<set_next_t, _Receiver&, __call_result_t<_Adaptor&, _Item>>
+      friend auto tag_invoke(set_next_t, __receiver& __self, _Item&& __item)
+        -> next_sender_of_t<_Receiver, __call_result_t<_Adaptor&, _Item>> {
+        return set_next(__self.__op_->__rcvr_, __self.__op_->__adaptor_((_Item&&) __item));
+      }
+
+      template <__completion_tag _Tag, class... _Args>
+        requires __callable<_Tag, _Receiver, _Args...>
+      friend void tag_invoke(_Tag __tag, __receiver&& __self, _Args&&... __args) noexcept {
+        __tag((_Receiver&&) __self.__op_->__rcvr_, (_Args&&) __args...);
+      }
+
+      friend env_of_t<_Receiver> tag_invoke(get_env_t, const __receiver& __self) noexcept {
+        return get_env(__self.__op_->__rcvr_);
+      }
+    };
+
+    template <class _CvrefSequenceId, class _ReceiverId, class _Adaptor>
+    struct __operation : __operation_base<_ReceiverId, _Adaptor> {
+      using _Sequence = __cvref_t<_CvrefSequenceId>;
+      using _Receiver = stdexec::__t<_ReceiverId>;
+      using __receiver_t = __receiver<_ReceiverId, _Adaptor>;
+
+      subscribe_result_t<_Sequence, __receiver_t> __op_;
+
+      template <class _Adaptor2>
+      __operation(_Sequence&& __sequence, _Receiver&& __rcvr, _Adaptor2&& __adaptor)
+        : __operation_base<_ReceiverId, _Adaptor>{
+          {},
+          (_Receiver&&) __rcvr,
+          (_Adaptor2&&) __adaptor}
+        , __op_(subscribe((_Sequence&&) __sequence, __receiver_t{this})) {
+      }
+
+      friend void tag_invoke(start_t, __operation& __self) noexcept {
+        start(__self.__op_);
+      }
+    };
+
+    template <class _SequenceId, class _Adaptor>
+    struct __sequence {
+      using _Sequence = stdexec::__t<_SequenceId>;
+
+      template <class _Item>
+      using __transformed_t = __call_result_t<_Adaptor&, _Item>;
+
+      using is_sender = void;
+      using item_types = __mapply<
+        __transform<__q<__transformed_t>, __q<exec::item_types>>,
+        item_types_of_t<_Sequence>>;
+
+      _Sequence __sequence_;
+      _Adaptor __adaptor_;
+
+      template <__decays_to<__sequence> _Self, receiver _Receiver>
+        requires sequence_receiver_of<_Receiver, item_types>
+              && __callable<
+                   subscribe_t,
+                   __copy_cvref_t<_Self, _Sequence>,
+                   __receiver<__x<_Receiver>, _Adaptor>>
+      friend __operation<__cvref_id<_Self, _Sequence>, __x<_Receiver>, _Adaptor>
+        tag_invoke(subscribe_t, _Self&& __self, _Receiver __rcvr) {
+        return {
+          ((_Self&&) __self).__sequence_, (_Receiver&&) __rcvr, ((_Self&&) __self).__adaptor_};
+      }
+
+      template <__decays_to<__sequence> _Self, class _Env>
+      friend auto tag_invoke(get_completion_signatures_t, _Self&&, _Env)
+        -> completion_signatures_of_t<__copy_cvref_t<_Self, _Sequence>, _Env> {
+        return {};
+      }
+
+      friend empty_env tag_invoke(get_env_t, const __sequence&) noexcept {
+        return {};
+      }
+    };
+
+    struct transform_each_t {
+      template <sequence_sender _Sequence, class _Adaptor>
+      __sequence<__x<__decay_t<_Sequence>>, __decay_t<_Adaptor>>
+        operator()(_Sequence&& __sequence, _Adaptor&& __adaptor) const {
+        return {(_Sequence&&) __sequence, (_Adaptor&&) __adaptor};
+      }
+
+      template <class _Adaptor>
+      __binder_back<transform_each_t, __decay_t<_Adaptor>> operator()(_Adaptor&& __adaptor) const {
+        return {{}, {}, {(_Adaptor&&) __adaptor}};
+      }
+    };
+  } // namespace __transform_each
+
+  using __transform_each::transform_each_t;
+  inline constexpr transform_each_t transform_each{};
+} // namespace exec
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "../stdexec/execution.hpp"
+
+#include <atomic>
+#include <variant>
+
+namespace exec {
+  /////////////////////////////////////////////////////////////////////////////
+  // Sequence senders produce any number of items before they complete.
+  //
+  // A sequence sender is subscribed to, rather than connected to, a receiver.
+  // For each item it calls set_next(rcvr, item), where item is a sender of the
+  // item's values, and connects and starts the returned next-sender. The
+  // next-sender completes with set_value() once the receiver is done with the
+  // item, or with set_stopped() if the receiver wants no more items. A
+  // sequence produces its next item only after the next-sender of the previous
+  // one has completed, unless it documents otherwise, so a slow receiver holds
+  // back the producer. Once it is done the sequence completes the receiver
+  // with set_value(), set_error() or set_stopped(), after all of its
+  // next-senders have completed.
+  //
+  // A sequence sender declares the types of its item senders as
+  //
+  //   using item_types = exec::item_types<Item...>;
+  //
+  // and its final completions as a sender does, so that it satisfies the
+  // sender concept; it cannot be connected though. See the adaptors in the
+  // exec/sequence directory, and ignore_all, which turns a sequence back into
+  // a sender.
+  namespace __sequence_senders {
+    using namespace stdexec;
+
+    struct set_next_t {
+      template <class _Receiver, sender _Item>
+        requires tag_invocable<set_next_t, _Receiver&, _Item>
+      auto operator()(_Receiver& __rcvr, _Item&& __item) const
+        noexcept(nothrow_tag_invocable<set_next_t, _Receiver&, _Item>)
+          -> tag_invoke_result_t<set_next_t, _Receiver&, _Item> {
+        static_assert(sender<tag_invoke_result_t<set_next_t, _Receiver&, _Item>>);
+        return tag_invoke(*this, __rcvr, (_Item&&) __item);
+      }
+    };
+
+    struct subscribe_t {
+      template <class _Sequence, receiver _Receiver>
+        requires tag_invocable<subscribe_t, _Sequence, _Receiver>
+      auto operator()(_Sequence&& __sequence, _Receiver&& __rcvr) const
+        noexcept(nothrow_tag_invocable<subscribe_t, _Sequence, _Receiver>)
+          -> tag_invoke_result_t<subscribe_t, _Sequence, _Receiver> {
+        static_assert(operation_state<tag_invoke_result_t<subscribe_t, _Sequence, _Receiver>>);
+        return tag_invoke(*this, (_Sequence&&) __sequence, (_Receiver&&) __rcvr);
+      }
+    };
+
+    // Keeps the first of the errors that concurrent operations report.
+    template <class _Variant>
+    struct __first_error {
+      std::atomic<bool> __set_{false};
+      _Variant __error_{};
+
+      template <class _Error>
+      void __store(_Error&& __error) noexcept {
+        if (!__set_.exchange(true, std::memory_order_relaxed)) {
+          __error_.template emplace<__decay_t<_Error>>((_Error&&) __error);
+        }
+      }
+
+      // The operations that may store an error must have completed before this is called.
+      bool __has_error() const noexcept {
+        return __set_.load(std::memory_order_relaxed);
+      }
+
+      template <class _Receiver>
+      void __complete(_Receiver&& __rcvr) noexcept {
+        std::visit(
+          [&]<class _Error>(_Error& __error) noexcept {
+            if constexpr (!same_as<_Error, std::monostate>) {
+              set_error((_Receiver&&) __rcvr, std::move(__error));
+            }
+          },
+          __error_);
+      }
+    };
+
+    template <class... _Errors>
+    using __first_error_t = __first_error<__minvoke<__nullable_variant_t, __decay_t<_Errors>...>>;
+
+    // Storage for the first error of the given completion signatures.
+    template <class _Completions>
+    using __first_error_for_t =
+      __gather_signal<set_error_t, _Completions, __q<__midentity>, __q<__first_error_t>>;
+  } // namespace __sequence_senders
+
+  using __sequence_senders::set_next_t;
+  using __sequence_senders::subscribe_t;
+  inline constexpr set_next_t set_next{};
+  inline constexpr subscribe_t subscribe{};
+
+  template <class... _Items>
+  struct item_types { };
+
+  template <class _Sequence>
+  using item_types_of_t = typename stdexec::__decay_t<_Sequence>::item_types;
+
+  template <class _Receiver, class _Item>
+  using next_sender_of_t = stdexec::__call_result_t<set_next_t, _Receiver&, _Item>;
+
+  template <class _Sequence, class _Receiver>
+  using subscribe_result_t = stdexec::__call_result_t<subscribe_t, _Sequence, _Receiver>;
+
+  template <class _Sequence, class _Env = stdexec::no_env>
+  concept sequence_sender =
+    stdexec::sender_in<_Sequence, _Env> && requires { typename item_types_of_t<_Sequence>; };
+
+  namespace __sequence_senders {
+    template <class _Receiver, class _Items>
+    inline constexpr bool __accepts_items_v = false;
+
+    template <class _Receiver, class... _Items>
+    inline constexpr bool __accepts_items_v<_Receiver, item_types<_Items...>> =
+      (__callable<set_next_t, _Receiver&, _Items> && ...);
+  } // namespace __sequence_senders
+
+  template <class _Receiver, class _Items>
+  concept sequence_receiver_of =
+    stdexec::receiver<_Receiver> && __sequence_senders::__accepts_items_v<_Receiver, _Items>;
+} // namespace exec
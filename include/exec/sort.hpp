@@ -0,0 +1,344 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "../stdexec/execution.hpp"
+#include "static_thread_pool.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+namespace exec {
+  /////////////////////////////////////////////////////////////////////////////
+  // sort(sch, range, comp, alloc): a sender that sorts the sized random access
+  // range in place on the scheduler and completes with the range. Pass a view
+  // such as std::span to sort the caller's elements, or a container to have
+  // it moved through the sender.
+  //
+  // Schedulers customize sort to sort in parallel; the allocator is for their
+  // scratch buffer. Otherwise the range is sorted with std::sort in a then.
+  namespace __sort {
+    using namespace stdexec;
+
+    template <class _Range, class _Compare>
+    concept __sortable_range = //
+      std::ranges::random_access_range<_Range> && std::ranges::sized_range<_Range>
+      && std::sortable<std::ranges::iterator_t<_Range>, _Compare>;
+
+    template <class _Range, class _Compare>
+    struct __sequential_fn {
+      _Range __range_;
+      _Compare __comp_;
+
+      _Range operator()() {
+        std::sort(std::ranges::begin(__range_), std::ranges::end(__range_), __comp_);
+        return std::move(__range_);
+      }
+    };
+
+    /////////////////////////////////////////////////////////////////////////////
+    // The parallel algorithm for schedulers that customize bulk is a sample
+    // sort with one bulk index per part:
+    //
+    //   1. Sample the range, and pick __parts_ - 1 splitters from the sorted
+    //      sample.
+    //   2. Count the elements of each part of the range that fall between
+    //      each pair of splitters, into each bucket.
+    //   3. Turn the counts into the position of each part's share of each
+    //      bucket in the scratch buffer.
+    //   4. Move each part's elements to their positions in the scratch buffer.
+    //   5. Sort each bucket, and move it back to the same positions in the
+    //      range.
+    //
+    // Each step after the first reads and writes disjoint memory per part.
+    // Ranges too small to be worth it are sorted by one part with std::sort.
+    inline constexpr std::size_t __min_part_size = 4096;
+    inline constexpr std::size_t __oversampling = 32;
+
+    template <class _Range, class _Compare, class _Alloc>
+    struct __state {
+      using __value_t = std::ranges::range_value_t<_Range>;
+
+      _Range __range_;
+      _Compare __comp_;
+      std::size_t __parts_;
+      std::vector<__value_t> __splitters_;
+      // The count of the elements of part __i in bucket __b at [__i * __parts_ + __b], which
+      // becomes the position of the next of them in the scratch buffer.
+      std::vector<std::size_t> __counts_;
+      // Bucket __b is [__bucket_begin_[__b], __bucket_begin_[__b + 1]) of the scratch buffer.
+      std::vector<std::size_t> __bucket_begin_;
+      std::vector<__value_t, _Alloc> __scratch_;
+
+      std::size_t __size() const noexcept {
+        return static_cast<std::size_t>(std::ranges::size(__range_));
+      }
+
+      // Part __i of __parts_, split like static_thread_pool's even_share.
+      std::pair<std::size_t, std::size_t> __part(std::size_t __i) const noexcept {
+        const std::size_t __per_part = __size() / __parts_;
+        const std::size_t __remainder = __size() % __parts_;
+        const std::size_t __begin = __i * __per_part + (std::min)(__i, __remainder);
+        return {__begin, __begin + __per_part + (__i < __remainder ? 1 : 0)};
+      }
+
+      template <class _Value>
+      std::size_t __bucket_of(const _Value& __value) {
+        return static_cast<std::size_t>(
+          std::upper_bound(__splitters_.begin(), __splitters_.end(), __value, std::ref(__comp_))
+          - __splitters_.begin());
+      }
+    };
+
+    template <class _Range, class _Compare, class _Alloc>
+    struct __make_state_fn {
+      _Range __range_;
+      _Compare __comp_;
+      _Alloc __alloc_;
+      std::size_t __max_parts_;
+
+      __state<_Range, _Compare, _Alloc> operator()() {
+        using __state_t = __state<_Range, _Compare, _Alloc>;
+        const auto __size = static_cast<std::size_t>(std::ranges::size(__range_));
+        const std::size_t __parts = std::clamp<std::size_t>(
+          __size / __min_part_size, 1, __max_parts_);
+        __state_t __state{
+          std::move(__range_),
+          std::move(__comp_),
+          __parts,
+          {},
+          {},
+          {},
+          std::vector<typename __state_t::__value_t, _Alloc>(std::move(__alloc_))};
+        if (__parts == 1) {
+          return __state;
+        }
+
+        auto __first = std::ranges::begin(__state.__range_);
+        const std::size_t __samples = __parts * __oversampling;
+        std::vector<typename __state_t::__value_t> __sample;
+        __sample.reserve(__samples);
+        for (std::size_t __i = 0; __i < __samples; ++__i) {
+          __sample.push_back(__first[static_cast<std::ptrdiff_t>(__i * __size / __samples)]);
+        }
+        std::sort(__sample.begin(), __sample.end(), std::ref(__state.__comp_));
+        __state.__splitters_.reserve(__parts - 1);
+        for (std::size_t __b = 1; __b < __parts; ++__b) {
+          __state.__splitters_.push_back(std::move(__sample[__b * __oversampling]));
+        }
+
+        __state.__counts_.resize(__parts * __parts);
+        __state.__bucket_begin_.resize(__parts + 1);
+        __state.__scratch_.resize(__size);
+        return __state;
+      }
+    };
+
+    struct __count_fn {
+      template <class _Range, class _Compare, class _Alloc>
+      void operator()(std::size_t __i, __state<_Range, _Compare, _Alloc>& __state) const {
+        if (__state.__parts_ == 1) {
+          if (__i == 0) {
+            std::sort(
+              std::ranges::begin(__state.__range_),
+              std::ranges::end(__state.__range_),
+              std::ref(__state.__comp_));
+          }
+          return;
+        }
+        if (__i >= __state.__parts_) {
+          return;
+        }
+        auto [__begin, __end] = __state.__part(__i);
+        auto __first = std::ranges::begin(__state.__range_);
+        std::size_t* __counts = __state.__counts_.data() + __i * __state.__parts_;
+        for (std::size_t __k = __begin; __k < __end; ++__k) {
+          ++__counts[__state.__bucket_of(__first[static_cast<std::ptrdiff_t>(__k)])];
+        }
+      }
+    };
+
+    struct __positions_fn {
+      template <class _Range, class _Compare, class _Alloc>
+      __state<_Range, _Compare, _Alloc>
+        operator()(__state<_Range, _Compare, _Alloc>&& __state) const {
+        const std::size_t __parts = __state.__parts_;
+        if (__parts == 1) {
+          return std::move(__state);
+        }
+        std::size_t __position = 0;
+        for (std::size_t __b = 0; __b < __parts; ++__b) {
+          __state.__bucket_begin_[__b] = __position;
+          for (std::size_t __i = 0; __i < __parts; ++__i) {
+            std::size_t& __count = __state.__counts_[__i * __parts + __b];
+            __position += std::exchange(__count, __position);
+          }
+        }
+        __state.__bucket_begin_[__parts] = __position;
+        return std::move(__state);
+      }
+    };
+
+    struct __scatter_fn {
+      template <class _Range, class _Compare, class _Alloc>
+      void operator()(std::size_t __i, __state<_Range, _Compare, _Alloc>& __state) const {
+        if (__state.__parts_ == 1 || __i >= __state.__parts_) {
+          return;
+        }
+        auto [__begin, __end] = __state.__part(__i);
+        auto __first = std::ranges::begin(__state.__range_);
+        std::size_t* __positions = __state.__counts_.data() + __i * __state.__parts_;
+        for (std::size_t __k = __begin; __k < __end; ++__k) {
+          auto&& __value = __first[static_cast<std::ptrdiff_t>(__k)];
+          const std::size_t __b = __state.__bucket_of(__value);
+          __state.__scratch_[__positions[__b]++] = std::ranges::iter_move(
+            __first + static_cast<std::ptrdiff_t>(__k));
+        }
+      }
+    };
+
+    struct __sort_bucket_fn {
+      template <class _Range, class _Compare, class _Alloc>
+      void operator()(std::size_t __b, __state<_Range, _Compare, _Alloc>& __state) const {
+        if (__state.__parts_ == 1 || __b >= __state.__parts_) {
+          return;
+        }
+        auto __scratch = __state.__scratch_.begin();
+        const auto __begin = static_cast<std::ptrdiff_t>(__state.__bucket_begin_[__b]);
+        const auto __end = static_cast<std::ptrdiff_t>(__state.__bucket_begin_[__b + 1]);
+        std::sort(__scratch + __begin, __scratch + __end, std::ref(__state.__comp_));
+        std::move(
+          __scratch + __begin, __scratch + __end, std::ranges::begin(__state.__range_) + __begin);
+      }
+    };
+
+    struct __release_range_fn {
+      template <class _Range, class _Compare, class _Alloc>
+      _Range operator()(__state<_Range, _Compare, _Alloc>&& __state) const {
+        return std::move(__state.__range_);
+      }
+    };
+
+    template <class _Range>
+    concept __sample_sortable = //
+      std::copyable<std::ranges::range_value_t<_Range>>
+      && std::default_initializable<std::ranges::range_value_t<_Range>>;
+
+    // For use by schedulers that customize sort in terms of their bulk. Elements that
+    // cannot be sampled or put in a scratch buffer are sorted sequentially.
+    template <scheduler _Scheduler, class _Range, class _Compare, class _Alloc>
+    auto __sample_sort(
+      _Scheduler __sched,
+      std::size_t __max_parts,
+      _Range __range,
+      _Compare __comp,
+      _Alloc __alloc) {
+      if constexpr (__sample_sortable<_Range>) {
+        const std::size_t __n = __max_parts == 0 ? 1 : __max_parts;
+        return then(
+          bulk(
+            bulk(
+              then(
+                bulk(
+                  then(
+                    schedule(__sched),
+                    __make_state_fn<_Range, _Compare, _Alloc>{
+                      (_Range&&) __range, (_Compare&&) __comp, (_Alloc&&) __alloc, __n}),
+                  __n,
+                  __count_fn{}),
+                __positions_fn{}),
+              __n,
+              __scatter_fn{}),
+            __n,
+            __sort_bucket_fn{}),
+          __release_range_fn{});
+      } else {
+        return then(
+          schedule(__sched),
+          __sequential_fn<_Range, _Compare>{(_Range&&) __range, (_Compare&&) __comp});
+      }
+    }
+
+    template <class _Range>
+    using __default_allocator = std::allocator<std::ranges::range_value_t<_Range>>;
+
+    struct sort_t {
+      template <
+        scheduler _Scheduler,
+        class _Range,
+        __movable_value _Compare = std::ranges::less,
+        class _Alloc = __default_allocator<__decay_t<_Range>>>
+        requires __sortable_range<__decay_t<_Range>, _Compare>
+              && tag_invocable<sort_t, _Scheduler, __decay_t<_Range>, _Compare, _Alloc>
+      sender auto operator()(
+        _Scheduler&& __sched,
+        _Range&& __range,
+        _Compare __comp = {},
+        _Alloc __alloc = {}) const
+        noexcept(nothrow_tag_invocable<sort_t, _Scheduler, __decay_t<_Range>, _Compare, _Alloc>) {
+        return tag_invoke(
+          sort_t{},
+          (_Scheduler&&) __sched,
+          __decay_t<_Range>{(_Range&&) __range},
+          (_Compare&&) __comp,
+          (_Alloc&&) __alloc);
+      }
+
+      template <
+        scheduler _Scheduler,
+        class _Range,
+        __movable_value _Compare = std::ranges::less,
+        class _Alloc = __default_allocator<__decay_t<_Range>>>
+        requires __sortable_range<__decay_t<_Range>, _Compare>
+              && (!tag_invocable<sort_t, _Scheduler, __decay_t<_Range>, _Compare, _Alloc>)
+      sender auto operator()(
+        _Scheduler&& __sched,
+        _Range&& __range,
+        _Compare __comp = {},
+        _Alloc = {}) const {
+        return then(
+          schedule((_Scheduler&&) __sched),
+          __sequential_fn<__decay_t<_Range>, _Compare>{(_Range&&) __range, (_Compare&&) __comp});
+      }
+
+      // On a static_thread_pool: a sample sort with one part per thread.
+      template <class _Range, class _Compare, class _Alloc>
+      friend auto tag_invoke(
+        sort_t,
+        const static_thread_pool::scheduler& __sched,
+        _Range __range,
+        _Compare __comp,
+        _Alloc __alloc) {
+        return __sort::__sample_sort(
+          __sched,
+          __sched.__available_parallelism(),
+          (_Range&&) __range,
+          (_Compare&&) __comp,
+          (_Alloc&&) __alloc);
+      }
+    };
+  } // namespace __sort
+
+  using __sort::sort_t;
+  inline constexpr sort_t sort{};
+} // namespace exec
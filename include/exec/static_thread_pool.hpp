@@ -20,11 +20,15 @@
 #include "../stdexec/__detail/__config.hpp"
 #include "../stdexec/__detail/__intrusive_queue.hpp"
 #include "../stdexec/__detail/__meta.hpp"
+#include "../stdexec/__detail/__queue_statistics.hpp"
+#include "__detail/__bulk_range_fn.hpp"
 
 #include <atomic>
 #include <condition_variable>
 #include <exception>
+#include <memory>
 #include <mutex>
+#include <span>
 #include <thread>
 #include <type_traits>
 #include <vector>
@@ -35,6 +39,8 @@ namespace exec {
   struct task_base {
     task_base* next;
     void (*__execute)(task_base*, std::uint32_t tid) noexcept;
+    // Stamped when the task is enqueued, if the pool keeps queue statistics.
+    std::uint64_t __enqueued_ns_ = 0;
   };
 
   template <typename ReceiverID>
@@ -53,6 +59,12 @@ namespace exec {
       using __id = scheduler;
       bool operator==(const scheduler&) const = default;
 
+      // The number of threads of the pool. The customizations of the parallel algorithms in
+      // their own headers split the work by it.
+      std::uint32_t __available_parallelism() const noexcept {
+        return pool_->threadCount_;
+      }
+
      private:
       template <typename ReceiverId>
       friend class operation;
@@ -134,8 +146,15 @@ namespace exec {
 
               auto computation = [&](auto&... args) {
                 auto [begin, end] = even_share(sh_state.shape_, tid, total_threads);
-                for (Shape i = begin; i < end; ++i) {
-                  sh_state.fn_(i, args...);
+                if constexpr (__bulk_chunked::__is_range_fn<Fun>) {
+                  // From exec::bulk_chunked: hand each thread's whole range to the function.
+                  if (begin < end) {
+                    sh_state.fn_.__fn_(begin, end, args...);
+                  }
+                } else {
+                  for (Shape i = begin; i < end; ++i) {
+                    sh_state.fn_(i, args...);
+                  }
                 }
               };
 
@@ -448,6 +467,14 @@ namespace exec {
       return threadCount_;
     }
 
+    // Records how long tasks wait in the queues and how long they run, per worker thread,
+    // from now on. Not thread-safe with itself. See exec/queue_statistics.hpp, whose
+    // exec::get_queue_statistics(pool) merges the statistics of all worker threads.
+    void enable_queue_statistics();
+
+    // The recorders of the worker threads, or none if statistics are not enabled.
+    std::span<const stdexec::__queue_stats::__recorder> __queue_statistics() const noexcept;
+
    private:
     class thread_state {
      public:
@@ -476,6 +503,8 @@ namespace exec {
     std::vector<std::thread> threads_;
     std::vector<thread_state> threadStates_;
     std::atomic<std::uint32_t> nextThread_;
+    std::unique_ptr<stdexec::__queue_stats::__recorder[]> statsStorage_;
+    std::atomic<stdexec::__queue_stats::__recorder*> stats_{nullptr};
   };
 
   template <typename ReceiverId>
@@ -568,8 +597,28 @@ namespace exec {
         }
       }
 
-      task->__execute(task, tid);
+      if (auto* stats = stats_.load(std::memory_order_acquire)) {
+        stdexec::__queue_stats::__run_recorded(
+          stats[index], task->__enqueued_ns_, [&]() noexcept { task->__execute(task, tid); });
+      } else {
+        task->__execute(task, tid);
+      }
+    }
+  }
+
+  inline void static_thread_pool::enable_queue_statistics() {
+    if (!statsStorage_) {
+      statsStorage_ = std::make_unique<stdexec::__queue_stats::__recorder[]>(threadCount_);
+      stats_.store(statsStorage_.get(), std::memory_order_release);
+    }
+  }
+
+  inline std::span<const stdexec::__queue_stats::__recorder>
+    static_thread_pool::__queue_statistics() const noexcept {
+    if (auto* stats = stats_.load(std::memory_order_acquire)) {
+      return {stats, threadCount_};
     }
+    return {};
   }
 
   inline void static_thread_pool::join() noexcept {
@@ -580,6 +629,9 @@ namespace exec {
   }
 
   inline void static_thread_pool::enqueue(task_base* task) noexcept {
+    if (stats_.load(std::memory_order_relaxed)) {
+      task->__enqueued_ns_ = stdexec::__queue_stats::__now_ns();
+    }
     const std::uint32_t threadCount = static_cast<std::uint32_t>(threads_.size());
     const std::uint32_t startIndex =
       nextThread_.fetch_add(1, std::memory_order_relaxed) % threadCount;
@@ -599,6 +651,12 @@ namespace exec {
 
   template <std::derived_from<task_base> TaskT>
   inline void static_thread_pool::bulk_enqueue(TaskT* task, std::uint32_t n_threads) noexcept {
+    if (stats_.load(std::memory_order_relaxed)) {
+      const std::uint64_t now = stdexec::__queue_stats::__now_ns();
+      for (std::size_t i = 0; i < n_threads; ++i) {
+        task[i].__enqueued_ns_ = now;
+      }
+    }
     for (std::size_t i = 0; i < n_threads; ++i) {
       threadStates_[i % available_parallelism()].push(task + i);
     }
@@ -17,7 +17,9 @@
 
 #include <any>
 #include <cassert>
+#include <cstddef>
 #include <exception>
+#include <memory>
 #include <utility>
 #include <variant>
 
@@ -140,6 +142,13 @@ namespace exec {
     template <class _Ty>
     using default_task_context = __default_task_context_impl<__scheduler_affinity::__sticky>;
 
+    template <class _Context>
+    inline constexpr bool __is_sticky_context = false;
+
+    template <>
+    inline constexpr bool
+      __is_sticky_context<__default_task_context_impl<__scheduler_affinity::__sticky>> = true;
+
     template <class _Ty>
     using __raw_task_context = __default_task_context_impl<__scheduler_affinity::__none>;
 
@@ -312,6 +321,429 @@ namespace exec {
       }
     };
 
+    ////////////////////////////////////////////////////////////////////////////////
+    // With sticky scheduler affinity, a task transitions back onto its scheduler after
+    // each co_await of a sender. The transition is skipped when it is known to be
+    // redundant: when the awaited sender completes on a scheduler that compares equal to
+    // the task's, or when it completes synchronously from within its own start(), on the
+    // thread that was already running the task. Completions that skip the transition
+    // resume the task on the current stack, so after __max_inline_depth nested ones the
+    // transition is taken anyway.
+    struct __sticky_state_base {
+      static constexpr int __max_inline_depth = 64;
+
+      // The sticky operation whose start() is running on this thread, if any.
+      static inline thread_local const __sticky_state_base* __starting_ = nullptr;
+      static inline thread_local int __inline_depth_ = 0;
+
+      bool __same_scheduler_;
+
+      bool __can_complete_inline() const noexcept {
+        return (__same_scheduler_ || __starting_ == this)
+            && __inline_depth_ < __max_inline_depth;
+      }
+    };
+
+    template <class _SchedulerId>
+    struct __sticky_state : __sticky_state_base {
+      stdexec::__t<_SchedulerId> __sched_;
+    };
+
+    template <class _SchedulerId>
+    struct __sticky_scheduler {
+      using _Scheduler = stdexec::__t<_SchedulerId>;
+      using __state_t = __sticky_state<_SchedulerId>;
+
+      template <class _ReceiverId>
+      struct __operation {
+        using _Receiver = stdexec::__t<_ReceiverId>;
+
+        struct __t {
+          using __id = __operation;
+          __state_t* __state_;
+          _Receiver __rcvr_;
+          std::optional<connect_result_t<schedule_result_t<_Scheduler&>, _Receiver>> __op_{};
+
+          friend void tag_invoke(start_t, __t& __self) noexcept {
+            if (__self.__state_->__can_complete_inline()) {
+              __sticky_state_base::__starting_ = nullptr;
+              ++__sticky_state_base::__inline_depth_;
+              set_value((_Receiver&&) __self.__rcvr_);
+              --__sticky_state_base::__inline_depth_;
+              return;
+            }
+            try {
+              __self.__op_.emplace(__conv{[&] {
+                return connect(schedule(__self.__state_->__sched_), (_Receiver&&) __self.__rcvr_);
+              }});
+            } catch (...) {
+              set_error((_Receiver&&) __self.__rcvr_, std::current_exception());
+              return;
+            }
+            start(*__self.__op_);
+          }
+        };
+      };
+
+      struct __t;
+
+      struct __env {
+        __state_t* __state_;
+
+        friend __t
+          tag_invoke(get_completion_scheduler_t<set_value_t>, const __env& __self) noexcept {
+          return {__self.__state_};
+        }
+      };
+
+      struct __sender {
+        using is_sender = void;
+        __state_t* __state_;
+
+        template <class _Env>
+        using __completions_t = make_completion_signatures<
+          schedule_result_t<_Scheduler&>,
+          _Env,
+          completion_signatures<set_value_t(), set_error_t(std::exception_ptr)>>;
+
+        template <class _Env>
+        friend auto tag_invoke(get_completion_signatures_t, const __sender&, _Env)
+          -> __completions_t<_Env>;
+
+        template <receiver _Receiver>
+          requires receiver_of<_Receiver, __completions_t<env_of_t<_Receiver>>>
+        friend auto tag_invoke(connect_t, const __sender& __self, _Receiver __rcvr)
+          -> stdexec::__t<__operation<stdexec::__id<_Receiver>>> {
+          return {__self.__state_, (_Receiver&&) __rcvr};
+        }
+
+        friend __env tag_invoke(get_env_t, const __sender& __self) noexcept {
+          return {__self.__state_};
+        }
+      };
+
+      struct __t {
+        using __id = __sticky_scheduler;
+        __state_t* __state_;
+
+        friend __sender tag_invoke(schedule_t, const __t& __self) noexcept {
+          return {__self.__state_};
+        }
+
+        bool operator==(const __t&) const noexcept = default;
+      };
+    };
+
+    template <class _SchedulerId, class _SenderId>
+    struct __sticky_sender {
+      using _Scheduler = stdexec::__t<_SchedulerId>;
+      using _Sender = stdexec::__t<_SenderId>;
+      using __scheduler_t = stdexec::__t<__sticky_scheduler<_SchedulerId>>;
+      using __transfer_t = __call_result_t<schedule_from_t, __scheduler_t, _Sender>;
+
+      template <class _ReceiverId>
+      struct __operation {
+        using _Receiver = stdexec::__t<_ReceiverId>;
+
+        struct __t : __sticky_state<_SchedulerId> {
+          using __id = __operation;
+          connect_result_t<__transfer_t, _Receiver> __op_;
+
+          __t(_Scheduler __sched, bool __same_scheduler, _Sender&& __sndr, _Receiver&& __rcvr)
+            : __sticky_state<_SchedulerId>{{__same_scheduler}, (_Scheduler&&) __sched}
+            , __op_(connect(
+                schedule_from(__scheduler_t{this}, (_Sender&&) __sndr),
+                (_Receiver&&) __rcvr)) {
+          }
+
+          STDEXEC_IMMOVABLE(__t);
+
+          friend void tag_invoke(start_t, __t& __self) noexcept {
+            const __sticky_state_base* __prev =
+              std::exchange(__sticky_state_base::__starting_, &__self);
+            start(__self.__op_);
+            __sticky_state_base::__starting_ = __prev;
+          }
+        };
+      };
+
+      struct __t {
+        using __id = __sticky_sender;
+        using is_sender = void;
+        _Sender __sndr_;
+        _Scheduler __sched_;
+        bool __same_scheduler_;
+
+        template <class _Receiver>
+        using __operation_t = stdexec::__t<__operation<stdexec::__id<_Receiver>>>;
+
+        template <receiver _Receiver>
+          requires sender_to<__transfer_t, _Receiver>
+        friend auto tag_invoke(connect_t, __t&& __self, _Receiver __rcvr)
+          -> __operation_t<_Receiver> {
+          return {
+            (_Scheduler&&) __self.__sched_,
+            __self.__same_scheduler_,
+            (_Sender&&) __self.__sndr_,
+            (_Receiver&&) __rcvr};
+        }
+
+        template <class _Env>
+        friend auto tag_invoke(get_completion_signatures_t, const __t&, _Env)
+          -> completion_signatures_of_t<__transfer_t, _Env>;
+
+        friend empty_env tag_invoke(get_env_t, const __t&) noexcept {
+          return {};
+        }
+      };
+    };
+
+    // Whether __other equals __sched, the type-erased scheduler of the task. The erased
+    // scheduler is only built when __other is not already one.
+    template <class _Other, class _Scheduler>
+    bool __same_scheduler(const _Other& __other, const _Scheduler& __sched) {
+      if constexpr (same_as<_Other, _Scheduler>) {
+        return __other == __sched;
+      } else if constexpr (constructible_from<_Scheduler, const _Other&>) {
+        return _Scheduler(__other) == __sched;
+      } else {
+        return false;
+      }
+    }
+
+    template <class _Tag, class _Sender, class _Env>
+    constexpr bool __never_sends() noexcept {
+      if constexpr (__valid<__count_of, _Tag, _Sender, _Env>) {
+        return !__sends<_Tag, _Sender, _Env>;
+      } else {
+        return false;
+      }
+    }
+
+    // Whether __sndr is known to complete with _Tag on a scheduler equal to __ref, which is
+    // known to equal __sched, or is known not to complete with _Tag at all. A completion
+    // scheduler of the same type as __ref is compared with it directly.
+    template <class _Tag, class _Env, class _Sender, class _Ref, class _Scheduler>
+    bool __completes_on(const _Sender& __sndr, const _Ref& __ref, const _Scheduler& __sched) {
+      if constexpr (__has_completion_scheduler<_Sender, _Tag>) {
+        auto __other = get_completion_scheduler<_Tag>(get_env(__sndr));
+        if constexpr (same_as<decltype(__other), _Ref>) {
+          return __other == __ref;
+        } else {
+          return __task::__same_scheduler(__other, __sched);
+        }
+      } else {
+        return __never_sends<_Tag, _Sender, _Env>();
+      }
+    }
+
+    // Whether __sndr is known to complete on a scheduler equal to __sched on each channel it
+    // completes on. This runs on every co_await, so the completion scheduler of the value
+    // channel is fetched and compared with __sched once, and those of the other channels
+    // are compared with it.
+    template <class _Env, class _Sender, class _Scheduler>
+    bool __completes_on(const _Sender& __sndr, const _Scheduler& __sched) noexcept {
+      try {
+        if constexpr (__has_completion_scheduler<_Sender, set_value_t>) {
+          auto __ref = get_completion_scheduler<set_value_t>(get_env(__sndr));
+          return __task::__same_scheduler(__ref, __sched)
+              && __task::__completes_on<set_error_t, _Env>(__sndr, __ref, __sched)
+              && __task::__completes_on<set_stopped_t, _Env>(__sndr, __ref, __sched);
+        } else {
+          return __never_sends<set_value_t, _Sender, _Env>()
+              && __task::__completes_on<set_error_t, _Env>(__sndr, __sched, __sched)
+              && __task::__completes_on<set_stopped_t, _Env>(__sndr, __sched, __sched);
+        }
+      } catch (...) {
+        return false;
+      }
+    }
+
+    template <class _Env, class _Sender, class _Scheduler>
+    auto __sticky_transfer(_Sender&& __sndr, const _Scheduler& __sched)
+      -> stdexec::__t<__sticky_sender<__id<_Scheduler>, __id<__decay_t<_Sender>>>> {
+      const bool __same_scheduler = __task::__completes_on<_Env>(__sndr, __sched);
+      return {(_Sender&&) __sndr, __sched, __same_scheduler};
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // A per-thread cache of free coroutine frames, bucketed by size. A deep tree of
+    // short-lived tasks reuses the same few frames instead of hitting the global heap on
+    // every call. Each bucket holds a bounded number of frames so the cache cannot grow
+    // without limit.
+    class __frame_cache {
+      static constexpr std::size_t __granularity = alignof(std::max_align_t);
+      static constexpr std::size_t __bucket_count = 64;
+      static constexpr std::size_t __max_frames_per_bucket = 16;
+
+      struct __free_frame {
+        __free_frame* __next_;
+      };
+
+      struct __bucket {
+        __free_frame* __head_{nullptr};
+        std::size_t __count_{0};
+      };
+
+      __bucket __buckets_[__bucket_count]{};
+
+      // Set once the thread's cache is destroyed. Frames that are released by other
+      // thread_local destructors after that point go to the global heap.
+      static inline thread_local bool __torn_down_ = false;
+
+      static constexpr std::size_t __bucket_of(std::size_t __size) noexcept {
+        return (__size - 1) / __granularity;
+      }
+
+     public:
+      __frame_cache() = default;
+      __frame_cache(__frame_cache&&) = delete;
+
+      ~__frame_cache() {
+        __torn_down_ = true;
+        for (__bucket& __b: __buckets_) {
+          while (__free_frame* __frame = __b.__head_) {
+            __b.__head_ = __frame->__next_;
+            ::operator delete(__frame);
+          }
+        }
+      }
+
+      // Returns nullptr if the thread's cache was already destroyed.
+      static __frame_cache* __get() noexcept {
+        if (__torn_down_) {
+          return nullptr;
+        }
+        thread_local __frame_cache __cache{};
+        return &__cache;
+      }
+
+      static void* __allocate(std::size_t __size) {
+        const std::size_t __index = __bucket_of(__size);
+        __frame_cache* __cache = __get();
+        if (__index >= __bucket_count || __cache == nullptr) {
+          return ::operator new(__size);
+        }
+        __bucket& __b = __cache->__buckets_[__index];
+        if (__free_frame* __frame = __b.__head_) {
+          __b.__head_ = __frame->__next_;
+          --__b.__count_;
+          return __frame;
+        }
+        return ::operator new((__index + 1) * __granularity);
+      }
+
+      static void __deallocate(void* __pointer, std::size_t __size) noexcept {
+        const std::size_t __index = __bucket_of(__size);
+        __frame_cache* __cache = __get();
+        if (
+          __cache != nullptr && __index < __bucket_count
+          && __cache->__buckets_[__index].__count_ < __max_frames_per_bucket) {
+          __bucket& __b = __cache->__buckets_[__index];
+          __b.__head_ = ::new (__pointer) __free_frame{__b.__head_};
+          ++__b.__count_;
+        } else {
+          ::operator delete(__pointer);
+        }
+      }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // Frame allocation for basic_task's promise. By default, frames come from the
+    // thread's __frame_cache. A task whose leading parameters are
+    // (std::allocator_arg_t, const Allocator&) allocates its frame with that allocator
+    // instead. Either way, a pointer to the matching deallocation function is stored
+    // just past the end of the frame, followed by the allocator if there is one.
+    struct __frame_allocation {
+      using __deallocate_fn = void(void*, std::size_t) noexcept;
+
+      static constexpr std::size_t __align_up(std::size_t __size, std::size_t __align) noexcept {
+        return (__size + __align - 1) & ~(__align - 1);
+      }
+
+      static constexpr std::size_t __fn_offset(std::size_t __size) noexcept {
+        return __align_up(__size, alignof(__deallocate_fn*));
+      }
+
+      template <class _Alloc>
+      static constexpr std::size_t __alloc_offset(std::size_t __size) noexcept {
+        return __align_up(__fn_offset(__size) + sizeof(__deallocate_fn*), alignof(_Alloc));
+      }
+
+      template <class _Alloc>
+      static constexpr std::size_t __blocks(std::size_t __size) noexcept {
+        return (__alloc_offset<_Alloc>(__size) + sizeof(_Alloc) + sizeof(std::max_align_t) - 1)
+             / sizeof(std::max_align_t);
+      }
+
+      template <class _Allocator>
+      using __block_alloc_t =
+        typename std::allocator_traits<_Allocator>::template rebind_alloc<std::max_align_t>;
+
+      static void
+        __set_deallocate(void* __frame, std::size_t __size, __deallocate_fn* __fn) noexcept {
+        using __fn_ptr_t = __deallocate_fn*;
+        ::new (static_cast<char*>(__frame) + __fn_offset(__size)) __fn_ptr_t{__fn};
+      }
+
+      static void __deallocate_cached(void* __frame, std::size_t __size) noexcept {
+        __frame_cache::__deallocate(
+          __frame, __fn_offset(__size) + sizeof(__deallocate_fn*));
+      }
+
+      template <class _Alloc>
+      static void __deallocate_with(void* __frame, std::size_t __size) noexcept {
+        _Alloc* __stored = std::launder(
+          reinterpret_cast<_Alloc*>(static_cast<char*>(__frame) + __alloc_offset<_Alloc>(__size)));
+        _Alloc __alloc{std::move(*__stored)};
+        __stored->~_Alloc();
+        std::allocator_traits<_Alloc>::deallocate(
+          __alloc, static_cast<std::max_align_t*>(__frame), __blocks<_Alloc>(__size));
+      }
+
+      static void* operator new(std::size_t __size) {
+        void* __frame = __frame_cache::__allocate(
+          __fn_offset(__size) + sizeof(__deallocate_fn*));
+        __set_deallocate(__frame, __size, &__deallocate_cached);
+        return __frame;
+      }
+
+      template <class _Allocator, class... _Args>
+      static void* operator new(
+        std::size_t __size,
+        std::allocator_arg_t,
+        const _Allocator& __alloc,
+        _Args&&...) {
+        using _Alloc = __block_alloc_t<_Allocator>;
+        static_assert(std::is_pointer_v<typename std::allocator_traits<_Alloc>::pointer>);
+        static_assert(alignof(_Alloc) <= alignof(std::max_align_t));
+        _Alloc __block_alloc{__alloc};
+        void* __frame = std::allocator_traits<_Alloc>::allocate(
+          __block_alloc, __blocks<_Alloc>(__size));
+        ::new (static_cast<char*>(__frame) + __alloc_offset<_Alloc>(__size))
+          _Alloc{std::move(__block_alloc)};
+        __set_deallocate(__frame, __size, &__deallocate_with<_Alloc>);
+        return __frame;
+      }
+
+      // For coroutines that are member functions, the implicit object parameter comes first.
+      template <class _Class, class _Allocator, class... _Args>
+      static void* operator new(
+        std::size_t __size,
+        _Class&,
+        std::allocator_arg_t,
+        const _Allocator& __alloc,
+        _Args&&...) {
+        return operator new(__size, std::allocator_arg, __alloc);
+      }
+
+      static void operator delete(void* __frame, std::size_t __size) noexcept {
+        __deallocate_fn* __fn = *std::launder(
+          reinterpret_cast<__deallocate_fn**>(static_cast<char*>(__frame) + __fn_offset(__size)));
+        __fn(__frame, __size);
+      }
+    };
+
     ////////////////////////////////////////////////////////////////////////////////
     // basic_task
     template <class _Ty, class _Context = default_task_context<_Ty>>
@@ -348,6 +780,7 @@ namespace exec {
 
       struct __promise
         : __promise_base<_Ty>
+        , __frame_allocation
         , with_awaitable_senders<__promise> {
         basic_task get_return_object() noexcept {
           return basic_task(__coro::coroutine_handle<__promise>::from_promise(*this));
@@ -372,10 +805,19 @@ namespace exec {
         template <sender _Awaitable>
           requires __scheduler_provider<_Context>
         decltype(auto) await_transform(_Awaitable&& __awaitable) noexcept {
-          // TODO: If we have a complete-where-it-starts query then we can optimize
-          // this to avoid the reschedule
           return as_awaitable(
-            transfer((_Awaitable&&) __awaitable, get_scheduler(__context_)), *this);
+            __task::__sticky_transfer<env_of_t<__promise&>>(
+              (_Awaitable&&) __awaitable, get_scheduler(__context_)),
+            *this);
+        }
+
+        // A sticky child task inherits this task's scheduler and is back on it when it
+        // completes, so it needs no transition. Awaiting it directly resumes the child and
+        // then this coroutine by symmetric transfer, and forwards the stop token as is.
+        template <class _Uy, class _ChildContext>
+          requires __scheduler_provider<_Context> && __is_sticky_context<_ChildContext>
+        decltype(auto) await_transform(__task::basic_task<_Uy, _ChildContext>&& __child) noexcept {
+          return as_awaitable(std::move(__child), *this);
         }
 
         template <class _Scheduler>
@@ -177,9 +177,9 @@ namespace exec {
 
   template <timed_scheduler _Scheduler>
   using schedule_after_result_t = //
-    stdexec::__call_result_t<schedule_after_t, _Scheduler>;
+    stdexec::__call_result_t<schedule_after_t, _Scheduler, const duration_of_t<_Scheduler>&>;
 
   template <timed_scheduler _Scheduler>
   using schedule_at_result_t = //
-    stdexec::__call_result_t<schedule_at_t, _Scheduler>;
+    stdexec::__call_result_t<schedule_at_t, _Scheduler, const time_point_of_t<_Scheduler>&>;
 }
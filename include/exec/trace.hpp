@@ -0,0 +1,375 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "../stdexec/execution.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+// Tracing is opt-in: unless STDEXEC_ENABLE_TRACING is defined to 1, exec::trace returns its
+// sender unchanged and nothing is recorded.
+#ifndef STDEXEC_ENABLE_TRACING
+#define STDEXEC_ENABLE_TRACING 0
+#endif
+
+namespace exec {
+  enum class trace_event_kind : unsigned char {
+    start,
+    set_value,
+    set_error,
+    set_stopped
+  };
+
+  // One event of a traced operation, as returned by collect_trace.
+  struct trace_event {
+    const char* name;
+    const void* operation;
+    std::uint64_t timestamp_ns;
+    std::uint32_t thread;
+    trace_event_kind kind;
+  };
+
+  namespace __trace {
+    using namespace stdexec;
+
+    // The events recorded by one thread. Only the owning thread writes, so recording is a
+    // handful of relaxed stores. The newest __capacity events are kept; each slot carries
+    // a sequence number so that a concurrent reader can tell a torn slot from a whole one.
+    class __buffer {
+     public:
+      static constexpr std::uint64_t __capacity = 1u << 14;
+
+      explicit __buffer(std::uint32_t __thread_index) noexcept
+        : __thread_(__thread_index) {
+      }
+
+      void __record(
+        const char* __name,
+        const void* __op,
+        trace_event_kind __kind,
+        std::uint64_t __timestamp_ns) noexcept {
+        const std::uint64_t __index = __head_.load(std::memory_order_relaxed);
+        __slot& __s = __slots_[__index % __capacity];
+        __s.__sequence_.store(2 * __index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        __s.__name_.store(__name, std::memory_order_relaxed);
+        __s.__op_.store(__op, std::memory_order_relaxed);
+        __s.__timestamp_ns_.store(__timestamp_ns, std::memory_order_relaxed);
+        __s.__kind_.store(__kind, std::memory_order_relaxed);
+        __s.__sequence_.store(2 * __index + 2, std::memory_order_release);
+        __head_.store(__index + 1, std::memory_order_release);
+      }
+
+      void __collect(std::vector<trace_event>& __events) const {
+        const std::uint64_t __head = __head_.load(std::memory_order_acquire);
+        const std::uint64_t __first = __head > __capacity ? __head - __capacity : 0;
+        for (std::uint64_t __index = __first; __index < __head; ++__index) {
+          const __slot& __s = __slots_[__index % __capacity];
+          if (__s.__sequence_.load(std::memory_order_acquire) != 2 * __index + 2) {
+            continue;
+          }
+          trace_event __event{
+            __s.__name_.load(std::memory_order_relaxed),
+            __s.__op_.load(std::memory_order_relaxed),
+            __s.__timestamp_ns_.load(std::memory_order_relaxed),
+            __thread_,
+            __s.__kind_.load(std::memory_order_relaxed)};
+          std::atomic_thread_fence(std::memory_order_acquire);
+          if (__s.__sequence_.load(std::memory_order_relaxed) == 2 * __index + 2) {
+            __events.push_back(__event);
+          }
+        }
+      }
+
+     private:
+      struct __slot {
+        std::atomic<std::uint64_t> __sequence_{0};
+        std::atomic<const char*> __name_{nullptr};
+        std::atomic<const void*> __op_{nullptr};
+        std::atomic<std::uint64_t> __timestamp_ns_{0};
+        std::atomic<trace_event_kind> __kind_{trace_event_kind::start};
+      };
+
+      std::atomic<std::uint64_t> __head_{0};
+      std::uint32_t __thread_;
+      std::unique_ptr<__slot[]> __slots_{new __slot[__capacity]};
+    };
+
+    // Keeps the buffers of the threads that are running, and of those that have exited until
+    // their events have been collected. At most __max_retired buffers of exited threads are
+    // kept; beyond that, the one of the thread that started tracing first is dropped.
+    class __registry {
+     public:
+      static constexpr std::size_t __max_retired = 16;
+
+      static __registry& __instance() {
+        static __registry __self;
+        return __self;
+      }
+
+      __buffer* __new_buffer() {
+        std::unique_lock __lock{__mutex_};
+        __entries_.push_back({std::make_unique<__buffer>(__next_thread_++), false});
+        return __entries_.back().__buf_.get();
+      }
+
+      void __retire(__buffer* __buf) noexcept {
+        std::unique_lock __lock{__mutex_};
+        auto __it = std::find_if(__entries_.begin(), __entries_.end(), [&](const __entry& __e) {
+          return __e.__buf_.get() == __buf;
+        });
+        __it->__retired_ = true;
+        if (++__retired_ > __max_retired) {
+          auto __is_retired = [](const __entry& __e) {
+            return __e.__retired_;
+          };
+          __entries_.erase(std::find_if(__entries_.begin(), __entries_.end(), __is_retired));
+          --__retired_;
+        }
+      }
+
+      // Collects the events of all buffers, and drops the buffers of exited threads, whose
+      // events are then returned only once.
+      std::vector<trace_event> __collect() {
+        std::vector<trace_event> __events;
+        std::unique_lock __lock{__mutex_};
+        for (const __entry& __e: __entries_) {
+          __e.__buf_->__collect(__events);
+        }
+        std::erase_if(__entries_, [](const __entry& __e) { return __e.__retired_; });
+        __retired_ = 0;
+        return __events;
+      }
+
+     private:
+      struct __entry {
+        std::unique_ptr<__buffer> __buf_;
+        bool __retired_;
+      };
+
+      std::mutex __mutex_;
+      std::vector<__entry> __entries_;
+      std::size_t __retired_ = 0;
+      std::uint32_t __next_thread_ = 0;
+    };
+
+    // The buffer of the calling thread, registered on first use and retired when the thread
+    // exits.
+    struct __thread_buffer {
+      __buffer* __buf_ = __registry::__instance().__new_buffer();
+
+      ~__thread_buffer() {
+        __registry::__instance().__retire(__buf_);
+      }
+    };
+
+    inline void
+      __record(const char* __name, const void* __op, trace_event_kind __kind) noexcept {
+      static thread_local __thread_buffer __self;
+      auto __now = std::chrono::steady_clock::now().time_since_epoch();
+      __self.__buf_->__record(
+        __name,
+        __op,
+        __kind,
+        static_cast<std::uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(__now).count()));
+    }
+
+    template <class _Tag>
+    inline constexpr trace_event_kind __kind_of = trace_event_kind::set_value;
+
+    template <>
+    inline constexpr trace_event_kind __kind_of<set_error_t> = trace_event_kind::set_error;
+
+    template <>
+    inline constexpr trace_event_kind __kind_of<set_stopped_t> = trace_event_kind::set_stopped;
+
+    template <class _ReceiverId>
+    struct __operation_base {
+      using _Receiver = stdexec::__t<_ReceiverId>;
+
+      const char* __name_;
+      _Receiver __rcvr_;
+    };
+
+    template <class _ReceiverId>
+    struct __receiver {
+      using _Receiver = stdexec::__t<_ReceiverId>;
+
+      struct __t {
+        using is_receiver = void;
+        using __id = __receiver;
+        __operation_base<_ReceiverId>* __op_;
+
+        // Records the completion before forwarding it, since forwarding may end the
+        // lifetime of the operation.
+        template <__completion_tag _Tag, class... _Args>
+          requires __callable<_Tag, _Receiver&&, _Args...>
+        friend void tag_invoke(_Tag, __t&& __self, _Args&&... __args) noexcept {
+          __trace::__record(__self.__op_->__name_, __self.__op_, __kind_of<_Tag>);
+          _Tag{}((_Receiver&&) __self.__op_->__rcvr_, (_Args&&) __args...);
+        }
+
+        friend env_of_t<_Receiver> tag_invoke(get_env_t, const __t& __self) noexcept {
+          return get_env(__self.__op_->__rcvr_);
+        }
+      };
+    };
+
+    template <class _Sender, class _ReceiverId>
+    struct __operation {
+      using _Receiver = stdexec::__t<_ReceiverId>;
+      using __receiver_t = stdexec::__t<__receiver<_ReceiverId>>;
+
+      struct __t : __operation_base<_ReceiverId> {
+        using __id = __operation;
+        connect_result_t<_Sender, __receiver_t> __op_;
+
+        __t(_Sender&& __sndr, const char* __name, _Receiver __rcvr)
+          : __operation_base<_ReceiverId>{__name, (_Receiver&&) __rcvr}
+          , __op_(connect((_Sender&&) __sndr, __receiver_t{this})) {
+        }
+
+        friend void tag_invoke(start_t, __t& __self) noexcept {
+          __operation_base<_ReceiverId>* __base = &__self;
+          __trace::__record(__self.__name_, __base, trace_event_kind::start);
+          start(__self.__op_);
+        }
+      };
+    };
+
+    template <class _SenderId>
+    struct __sender {
+      using _Sender = stdexec::__t<_SenderId>;
+
+      template <class _Self, class _Receiver>
+      using __operation_t =
+        stdexec::__t<__operation<__copy_cvref_t<_Self, _Sender>, stdexec::__id<_Receiver>>>;
+      template <class _Receiver>
+      using __receiver_t = stdexec::__t<__receiver<stdexec::__id<_Receiver>>>;
+
+      struct __t {
+        using __id = __sender;
+        using is_sender = void;
+
+        _Sender __sndr_;
+        const char* __name_;
+
+        template <__decays_to<__t> _Self, receiver _Receiver>
+          requires sender_to<__copy_cvref_t<_Self, _Sender>, __receiver_t<_Receiver>>
+        friend auto tag_invoke(connect_t, _Self&& __self, _Receiver __rcvr)
+          -> __operation_t<_Self, _Receiver> {
+          return {((_Self&&) __self).__sndr_, __self.__name_, (_Receiver&&) __rcvr};
+        }
+
+        template <__decays_to<__t> _Self, class _Env>
+        friend auto tag_invoke(get_completion_signatures_t, _Self&&, _Env)
+          -> make_completion_signatures<__copy_cvref_t<_Self, _Sender>, _Env>;
+
+        friend auto tag_invoke(get_env_t, const __t& __self) //
+          noexcept(__nothrow_callable<get_env_t, const _Sender&>)
+            -> __call_result_t<get_env_t, const _Sender&> {
+          return get_env(__self.__sndr_);
+        }
+      };
+    };
+
+    /////////////////////////////////////////////////////////////////////////////
+    // trace(sndr, name): records the start of each operation of sndr and its completion
+    // into a per-thread ring buffer, under the given name, which must outlive the trace.
+    struct trace_t {
+#if STDEXEC_ENABLE_TRACING
+      template <sender _Sender>
+      stdexec::__t<__sender<stdexec::__id<__decay_t<_Sender>>>>
+        operator()(_Sender&& __sndr, const char* __name) const
+        noexcept(__nothrow_decay_copyable<_Sender>) {
+        return {(_Sender&&) __sndr, __name};
+      }
+#else
+      template <sender _Sender>
+      __decay_t<_Sender> operator()(_Sender&& __sndr, const char*) const
+        noexcept(__nothrow_decay_copyable<_Sender>) {
+        return (_Sender&&) __sndr;
+      }
+#endif
+
+      __binder_back<trace_t, const char*> operator()(const char* __name) const noexcept {
+        return {{}, {}, {__name}};
+      }
+    };
+  } // namespace __trace
+
+  using __trace::trace_t;
+  inline constexpr trace_t trace{};
+
+  // The recorded events of all threads that are still in their ring buffers, per thread in
+  // the order they were recorded. The events of a thread that has exited are returned by
+  // one call only, after which its buffer is freed.
+  inline std::vector<trace_event> collect_trace() {
+    return __trace::__registry::__instance().__collect();
+  }
+
+  // Writes the recorded events in the Chrome trace event format, which Perfetto and
+  // chrome://tracing load. Each operation is an async slice from start to completion, so
+  // operations that complete on another thread than they started on are shown whole.
+  inline void write_chrome_trace(std::ostream& __out) {
+    std::vector<trace_event> __events = collect_trace();
+    std::stable_sort(__events.begin(), __events.end(), [](const auto& __a, const auto& __b) {
+      return __a.timestamp_ns < __b.timestamp_ns;
+    });
+    __out << "{\"traceEvents\":[";
+    const char* __separator = "\n";
+    for (const trace_event& __event: __events) {
+      char __ts[32];
+      std::snprintf(__ts, sizeof(__ts), "%.3f", static_cast<double>(__event.timestamp_ns) / 1e3);
+      __out << __separator << "{\"name\":\"";
+      for (const char* __c = __event.name; *__c != '\0'; ++__c) {
+        if (*__c == '"' || *__c == '\\') {
+          __out << '\\';
+        }
+        __out << *__c;
+      }
+      __out << "\",\"cat\":\"stdexec\",\"ph\":\""
+            << (__event.kind == trace_event_kind::start ? 'b' : 'e') << "\",\"id\":\""
+            << __event.operation << "\",\"ts\":" << __ts << ",\"pid\":1,\"tid\":" << __event.thread;
+      switch (__event.kind) {
+      case trace_event_kind::start:
+        break;
+      case trace_event_kind::set_value:
+        __out << ",\"args\":{\"completion\":\"set_value\"}";
+        break;
+      case trace_event_kind::set_error:
+        __out << ",\"args\":{\"completion\":\"set_error\"}";
+        break;
+      case trace_event_kind::set_stopped:
+        __out << ",\"args\":{\"completion\":\"set_stopped\"}";
+        break;
+      }
+      __out << '}';
+      __separator = ",\n";
+    }
+    __out << "\n]}\n";
+  }
+} // namespace exec
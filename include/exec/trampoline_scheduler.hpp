@@ -19,18 +19,35 @@
 #include "../stdexec/execution.hpp"
 
 #include <cstddef>
+#include <cstdint>
 #include <type_traits>
 #include <utility>
 
 namespace exec {
+  // Counts of how trampoline_scheduler's schedule operations were started on the calling
+  // thread: executed inline, or deferred to the outermost trampoline frame because the
+  // recursion or stack budget was used up. A high share of deferrals in a deep synchronous
+  // pipeline suggests a larger budget.
+  struct trampoline_statistics {
+    std::size_t inline_starts = 0;
+    std::size_t deferred_starts = 0;
+  };
+
   namespace __trampoline {
     using namespace stdexec;
 
+    inline std::uintptr_t __stack_address() noexcept {
+      const char __marker{};
+      return reinterpret_cast<std::uintptr_t>(&__marker);
+    }
+
     template <class _Operation>
     struct __trampoline_state {
       static thread_local __trampoline_state* __current_;
+      static thread_local trampoline_statistics __statistics_;
 
-      __trampoline_state() noexcept {
+      explicit __trampoline_state(std::uintptr_t __stack_base) noexcept
+        : __stack_base_(__stack_base) {
         __current_ = this;
       }
 
@@ -38,31 +55,74 @@ namespace exec {
         __current_ = nullptr;
       }
 
+      // The number of bytes of stack used since the trampoline was entered, whichever way
+      // the stack grows.
+      std::size_t __stack_used(std::uintptr_t __here) const noexcept {
+        return __here < __stack_base_ ? __stack_base_ - __here : __here - __stack_base_;
+      }
+
+      void __defer(_Operation* __op) noexcept {
+        ++__statistics_.deferred_starts;
+        __op->__next_ = nullptr;
+        (__tail_ != nullptr ? __tail_->__next_ : __head_) = __op;
+        __tail_ = __op;
+      }
+
       void __drain() noexcept;
 
       std::size_t __recursion_depth_ = 1;
+      std::uintptr_t __stack_base_;
       _Operation* __head_ = nullptr;
+      _Operation* __tail_ = nullptr;
     };
 
+    // A schedule operation runs inline unless that would nest more than
+    // __max_recursion_depth_ operations, or use more than __max_stack_bytes_ of stack, above
+    // the outermost one on this thread. Otherwise it is queued and runs, in FIFO order, once
+    // the outermost operation returns.
     class __scheduler {
+      static constexpr std::size_t __default_max_stack_bytes = 64 * 1024;
+
       std::size_t __max_recursion_depth_;
+      std::size_t __max_stack_bytes_;
 
      public:
       __scheduler() noexcept
-        : __max_recursion_depth_(16) {
+        : __max_recursion_depth_(~std::size_t{0})
+        , __max_stack_bytes_(__default_max_stack_bytes) {
       }
 
       explicit __scheduler(std::size_t __max_recursion_depth) noexcept
-        : __max_recursion_depth_(__max_recursion_depth) {
+        : __max_recursion_depth_(__max_recursion_depth)
+        , __max_stack_bytes_(__default_max_stack_bytes) {
+      }
+
+      __scheduler(std::size_t __max_recursion_depth, std::size_t __max_stack_bytes) noexcept
+        : __max_recursion_depth_(__max_recursion_depth)
+        , __max_stack_bytes_(__max_stack_bytes) {
       }
 
+      // The counts for the calling thread.
+      static trampoline_statistics statistics() noexcept;
+      static void reset_statistics() noexcept;
+
      private:
+      struct __limits {
+        std::size_t __max_recursion_depth_;
+        std::size_t __max_stack_bytes_;
+      };
+
+      explicit __scheduler(__limits __lim) noexcept
+        : __max_recursion_depth_(__lim.__max_recursion_depth_)
+        , __max_stack_bytes_(__lim.__max_stack_bytes_) {
+      }
+
       struct __operation_base {
         using __execute_fn = void(__operation_base*) noexcept;
 
-        explicit __operation_base(__execute_fn* __execute, std::size_t __max_depth) noexcept
+        explicit __operation_base(__execute_fn* __execute, __limits __lim) noexcept
           : __execute_(__execute)
-          , __max_recursion_depth_(__max_depth) {
+          , __limits_(__lim) {
         }
 
         void __execute() noexcept {
@@ -70,24 +130,30 @@ namespace exec {
         }
 
         friend void tag_invoke(start_t, __operation_base& __self) noexcept {
-          auto* __current_state = __trampoline_state<__operation_base>::__current_;
+          using __state_t = __trampoline_state<__operation_base>;
+          auto* __current_state = __state_t::__current_;
+          const std::uintptr_t __here = __stack_address();
           if (__current_state == nullptr) {
-            __trampoline_state<__operation_base> __state;
+            ++__state_t::__statistics_.inline_starts;
+            __state_t __state{__here};
             __self.__execute();
             __state.__drain();
-          } else if (__current_state->__recursion_depth_ < __self.__max_recursion_depth_) {
+          } else if (
+            __current_state->__recursion_depth_ < __self.__limits_.__max_recursion_depth_
+            && __current_state->__stack_used(__here) < __self.__limits_.__max_stack_bytes_) {
+            ++__state_t::__statistics_.inline_starts;
             ++__current_state->__recursion_depth_;
             __self.__execute();
+            --__current_state->__recursion_depth_;
           } else {
-            // Exceeded recursion limit.
-            __self.__next_ = std::exchange(
-              __current_state->__head_, static_cast<__operation_base*>(&__self));
+            // Exceeded the recursion or stack budget.
+            __current_state->__defer(&__self);
           }
         }
 
         __operation_base* __next_ = nullptr;
         __execute_fn* __execute_;
-        std::size_t __max_recursion_depth_;
+        __limits __limits_;
       };
 
       template <class _ReceiverId>
@@ -98,9 +164,9 @@ namespace exec {
           using __id = __operation;
           STDEXEC_NO_UNIQUE_ADDRESS _Receiver __receiver_;
 
-          explicit __t(_Receiver __rcvr, std::size_t __max_depth) noexcept(
+          explicit __t(_Receiver __rcvr, __limits __lim) noexcept(
             __nothrow_decay_copyable<_Receiver>)
-            : __operation_base(&__t::__execute_impl, __max_depth)
+            : __operation_base(&__t::__execute_impl, __lim)
             , __receiver_((_Receiver&&) __rcvr) {
           }
 
@@ -130,14 +196,14 @@ namespace exec {
         using completion_signatures =
           stdexec::completion_signatures<set_value_t(), set_stopped_t()>;
 
-        explicit __schedule_sender(std::size_t __max_depth) noexcept
-          : __max_recursion_depth_(__max_depth) {
+        explicit __schedule_sender(__limits __lim) noexcept
+          : __limits_(__lim) {
         }
 
         template <receiver_of<completion_signatures> _Receiver>
         __operation_t<_Receiver> __make_operation(_Receiver __rcvr) const
           noexcept(__nothrow_decay_copyable<_Receiver>) {
-          return __operation_t<_Receiver>{(_Receiver&&) __rcvr, __max_recursion_depth_};
+          return __operation_t<_Receiver>{(_Receiver&&) __rcvr, __limits_};
         }
 
         template <receiver_of<completion_signatures> _Receiver>
@@ -146,9 +212,13 @@ namespace exec {
           return __self.__make_operation((_Receiver&&) __rcvr);
         }
 
+        __scheduler __get_scheduler() const noexcept {
+          return __scheduler{__limits_};
+        }
+
         friend __scheduler
           tag_invoke(get_completion_scheduler_t<set_value_t>, __schedule_sender __self) noexcept {
-          return __scheduler{__self.__max_recursion_depth_};
+          return __self.__get_scheduler();
         }
 
         friend const __schedule_sender&
@@ -156,11 +226,11 @@ namespace exec {
           return __self;
         }
 
-        std::size_t __max_recursion_depth_;
+        __limits __limits_;
       };
 
       friend __schedule_sender tag_invoke(schedule_t, __scheduler __self) noexcept {
-        return __schedule_sender{__self.__max_recursion_depth_};
+        return __schedule_sender{{__self.__max_recursion_depth_, __self.__max_stack_bytes_}};
       }
 
      public:
@@ -171,14 +241,28 @@ namespace exec {
     thread_local __trampoline_state<_Operation>* __trampoline_state<_Operation>::__current_ =
       nullptr;
 
+    template <class _Operation>
+    thread_local trampoline_statistics __trampoline_state<_Operation>::__statistics_{};
+
     template <class _Operation>
     void __trampoline_state<_Operation>::__drain() noexcept {
       while (__head_ != nullptr) {
         _Operation* __op = std::exchange(__head_, __head_->__next_);
+        if (__head_ == nullptr) {
+          __tail_ = nullptr;
+        }
         __recursion_depth_ = 1;
         __op->__execute();
       }
     }
+
+    inline trampoline_statistics __scheduler::statistics() noexcept {
+      return __trampoline_state<__operation_base>::__statistics_;
+    }
+
+    inline void __scheduler::reset_statistics() noexcept {
+      __trampoline_state<__operation_base>::__statistics_ = {};
+    }
   } // namespace __trampoline
 
   using trampoline_scheduler = __trampoline::__scheduler;
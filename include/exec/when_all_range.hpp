@@ -0,0 +1,406 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "../stdexec/execution.hpp"
+
+#include "__detail/__manual_lifetime.hpp"
+#include "__detail/__sender_ranges.hpp"
+
+#include <limits>
+#include <stdexcept>
+
+namespace exec {
+  /////////////////////////////////////////////////////////////////////////////
+  // when_all_range: like when_all, but over a runtime-sized range of
+  // senders that all have the same type.
+  //
+  // The child operation states live in one contiguous allocation made at
+  // connect time with the receiver's allocator, and the values are collected
+  // into a std::vector. An optional second argument bounds the number of
+  // children that are in flight at once; each of these "lanes" reuses its
+  // operation state slot for the next child when the previous one completes.
+  namespace __when_all_range {
+    using namespace stdexec;
+    using namespace __sender_ranges;
+
+    enum __state_t {
+      __started,
+      __error,
+      __stopped
+    };
+
+    struct __on_stop_requested {
+      in_place_stop_source& __stop_source_;
+
+      void operator()() noexcept {
+        __stop_source_.request_stop();
+      }
+    };
+
+    template <class _BaseEnv>
+    using __env_t = __make_env_t<_BaseEnv, __with<get_stop_token_t, in_place_stop_token>>;
+
+    template <class... _Errors>
+    using __as_errors = completion_signatures<set_error_t(__decay_t<_Errors>)...>;
+
+    template <class _Sender, class _Env>
+    using __completion_signatures_t = __concat_completion_signatures_t<
+      completion_signatures<
+        __set_value_sig_t<__element_of_t<_Sender, __env_t<_Env>>>,
+        set_error_t(std::exception_ptr),
+        set_stopped_t()>,
+      error_types_of_t<_Sender, __env_t<_Env>, __as_errors>>;
+
+    template <class _Sender, class _Env>
+    using __errors_variant_t = __minvoke<
+      __mconcat<__transform<__q<__decay_t>, __nullable_variant_t>>,
+      __types<std::exception_ptr>,
+      error_types_of_t<_Sender, __env_t<_Env>, __types>>;
+
+    template <class _RangeId, class _ReceiverId>
+    struct __operation {
+      struct __t;
+    };
+
+    template <class _RangeId, class _ReceiverId>
+    struct __receiver {
+      using _Receiver = stdexec::__t<_ReceiverId>;
+      using __op_t = stdexec::__t<__operation<_RangeId, _ReceiverId>>;
+
+      struct __t {
+        using __id = __receiver;
+        using is_receiver = void;
+
+        __op_t* __op_;
+        std::size_t __lane_;
+        std::size_t __index_;
+
+        template <same_as<set_value_t> _Tag, class... _Values>
+        friend void tag_invoke(_Tag, __t&& __self, _Values&&... __vals) noexcept {
+          __self.__op_->__set_value(__self.__index_, (_Values&&) __vals...);
+          __self.__op_->__child_complete(__self.__lane_);
+        }
+
+        template <same_as<set_error_t> _Tag, class _Error>
+        friend void tag_invoke(_Tag, __t&& __self, _Error&& __err) noexcept {
+          __self.__op_->__set_error((_Error&&) __err);
+          __self.__op_->__child_complete(__self.__lane_);
+        }
+
+        template <same_as<set_stopped_t> _Tag>
+        friend void tag_invoke(_Tag, __t&& __self) noexcept {
+          __self.__op_->__set_stopped();
+          __self.__op_->__child_complete(__self.__lane_);
+        }
+
+        friend __env_t<env_of_t<_Receiver>> tag_invoke(get_env_t, const __t& __self) noexcept {
+          return __make_env(
+            get_env(__self.__op_->__rcvr_),
+            __with_(get_stop_token, __self.__op_->__stop_source_.get_token()));
+        }
+      };
+    };
+
+    template <class _RangeId, class _ReceiverId>
+    struct __operation<_RangeId, _ReceiverId>::__t : __immovable {
+      using __id = __operation;
+      using _Range = stdexec::__t<_RangeId>;
+      using _Receiver = stdexec::__t<_ReceiverId>;
+      using _Env = env_of_t<_Receiver>;
+      using __receiver_t = stdexec::__t<__receiver<_RangeId, _ReceiverId>>;
+      using __child_t = __child_sender_t<_Range&>;
+      using __child_op_t = connect_result_t<__child_t, __receiver_t>;
+      using __element_t = __element_of_t<__child_t, __env_t<_Env>>;
+      using __errors_variant = __errors_variant_t<__child_t, _Env>;
+      using __on_stop = std::optional<
+        typename stop_token_of_t<_Env&>::template callback_type<__on_stop_requested>>;
+
+      // One slot per child that may be in flight at a time. __state_ is the
+      // handshake between the loop that starts a child and that child's
+      // completion; whichever gets there second keeps the lane going.
+      struct __lane {
+        __manual_lifetime<__child_op_t> __op_;
+        std::atomic<bool> __state_{false};
+        bool __engaged_{false};
+      };
+
+      using __allocator_t = __allocator_for_t<_Env, __lane>;
+      using __traits_t = std::allocator_traits<__allocator_t>;
+
+      template <class _Range2>
+      __t(_Range2&& __range, _Receiver __rcvr, std::size_t __max_concurrency)
+        : __range_((_Range2&&) __range)
+        , __rcvr_((_Receiver&&) __rcvr)
+        , __size_(static_cast<std::size_t>(std::ranges::size(__range_)))
+        , __n_lanes_(std::min(__size_, __max_concurrency))
+        , __active_lanes_(__n_lanes_)
+        , __alloc_(__sender_ranges::__get_allocator(get_env(__rcvr_))) {
+        if constexpr (!same_as<__element_t, void>) {
+          __values_.resize(__size_);
+        }
+        if (__n_lanes_ != 0) {
+          __lanes_ = __traits_t::allocate(__alloc_, __n_lanes_);
+          for (std::size_t __i = 0; __i < __n_lanes_; ++__i) {
+            __traits_t::construct(__alloc_, __lanes_ + __i);
+          }
+        }
+      }
+
+      ~__t() {
+        for (std::size_t __i = 0; __i < __n_lanes_; ++__i) {
+          if (__lanes_[__i].__engaged_) {
+            __lanes_[__i].__op_.__destruct();
+          }
+          __traits_t::destroy(__alloc_, __lanes_ + __i);
+        }
+        if (__lanes_ != nullptr) {
+          __traits_t::deallocate(__alloc_, __lanes_, __n_lanes_);
+        }
+      }
+
+      template <class... _Values>
+      void __set_value(std::size_t __index, _Values&&... __vals) noexcept {
+        if constexpr (!same_as<__element_t, void>) {
+          // We only need to bother recording the completion values
+          // if we're not already in the "error" or "stopped" state.
+          if (__state_.load(std::memory_order_relaxed) == __started) {
+            try {
+              __sender_ranges::__store_value<__element_t>(
+                __values_, __index, (_Values&&) __vals...);
+            } catch (...) {
+              __set_error(std::current_exception());
+            }
+          }
+        }
+      }
+
+      template <class _Error>
+      void __set_error(_Error&& __err) noexcept {
+        if (__error != __state_.exchange(__error)) {
+          __stop_source_.request_stop();
+          // We won the race, free to write the error into the operation
+          // state without worry.
+          try {
+            __errors_.template emplace<__decay_t<_Error>>((_Error&&) __err);
+          } catch (...) {
+            __errors_.template emplace<std::exception_ptr>(std::current_exception());
+          }
+        }
+      }
+
+      void __set_stopped() noexcept {
+        __state_t __expected = __started;
+        // Transition to the "stopped" state if and only if we're in the
+        // "started" state. (If this fails, it's because we're in an
+        // error state, which trumps cancellation.)
+        if (__state_.compare_exchange_strong(__expected, __stopped)) {
+          __stop_source_.request_stop();
+        }
+      }
+
+      // Starts the children assigned to __lanes_[__l] one after another, for
+      // as long as they complete before start() returns. Once a child is
+      // left running, its completion picks the loop up again.
+      void __run_lane(std::size_t __l) noexcept {
+        __lane& __ln = __lanes_[__l];
+        while (true) {
+          if (__ln.__engaged_) {
+            __ln.__op_.__destruct();
+            __ln.__engaged_ = false;
+          }
+          if (__stop_source_.stop_requested()) {
+            __set_stopped();
+            return __finish_lane();
+          }
+          const std::size_t __index = __next_.fetch_add(1, std::memory_order_relaxed);
+          if (__index >= __size_) {
+            return __finish_lane();
+          }
+          try {
+            __ln.__op_.__construct_with([&] {
+              return stdexec::connect(
+                std::ranges::iter_move(std::ranges::begin(__range_) + __index),
+                __receiver_t{this, __l, __index});
+            });
+            __ln.__engaged_ = true;
+          } catch (...) {
+            __set_error(std::current_exception());
+            return __finish_lane();
+          }
+          __ln.__state_.store(false, std::memory_order_relaxed);
+          stdexec::start(__ln.__op_.__get());
+          if (!__ln.__state_.exchange(true, std::memory_order_acq_rel)) {
+            // The child is still running. Its completion continues the lane.
+            return;
+          }
+        }
+      }
+
+      void __child_complete(std::size_t __l) noexcept {
+        if (__lanes_[__l].__state_.exchange(true, std::memory_order_acq_rel)) {
+          // The loop in __run_lane has already returned:
+          __run_lane(__l);
+        }
+      }
+
+      void __finish_lane() noexcept {
+        if (__active_lanes_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+          __complete();
+        }
+      }
+
+      void __complete() noexcept {
+        // Stop callback is no longer needed. Destroy it.
+        __on_stop_.reset();
+        switch (__state_.load(std::memory_order_relaxed)) {
+        case __started:
+          if constexpr (same_as<__element_t, void>) {
+            stdexec::set_value((_Receiver&&) __rcvr_);
+          } else {
+            try {
+              stdexec::set_value(
+                (_Receiver&&) __rcvr_,
+                __sender_ranges::__take_values<__element_t>(__values_, __size_));
+            } catch (...) {
+              stdexec::set_error((_Receiver&&) __rcvr_, std::current_exception());
+            }
+          }
+          break;
+        case __error:
+          std::visit(
+            [this]<class _Error>(_Error& __err) noexcept {
+              if constexpr (!same_as<_Error, std::monostate>) {
+                stdexec::set_error((_Receiver&&) __rcvr_, (_Error&&) __err);
+              }
+            },
+            __errors_);
+          break;
+        case __stopped:
+          stdexec::set_stopped((_Receiver&&) __rcvr_);
+          break;
+        default:;
+        }
+      }
+
+      friend void tag_invoke(start_t, __t& __self) noexcept {
+        // register stop callback:
+        __self.__on_stop_.emplace(
+          get_stop_token(get_env(__self.__rcvr_)), __on_stop_requested{__self.__stop_source_});
+        if (__self.__stop_source_.stop_requested()) {
+          // Stop has already been requested. Don't bother starting
+          // the child operations.
+          __self.__on_stop_.reset();
+          stdexec::set_stopped((_Receiver&&) __self.__rcvr_);
+        } else if (__self.__n_lanes_ == 0) {
+          __self.__complete();
+        } else {
+          // The last lane to finish completes the operation, which may
+          // destroy *this, so don't touch it after starting the last lane.
+          const std::size_t __n_lanes = __self.__n_lanes_;
+          for (std::size_t __l = 0; __l < __n_lanes; ++__l) {
+            __self.__run_lane(__l);
+          }
+        }
+      }
+
+      _Range __range_;
+      _Receiver __rcvr_;
+      std::size_t __size_;
+      std::size_t __n_lanes_;
+      std::atomic<std::size_t> __next_{0};
+      std::atomic<std::size_t> __active_lanes_;
+      std::atomic<__state_t> __state_{__started};
+      in_place_stop_source __stop_source_{};
+      __on_stop __on_stop_{};
+      __errors_variant __errors_{};
+      STDEXEC_NO_UNIQUE_ADDRESS __values_t<__element_t> __values_{};
+      STDEXEC_NO_UNIQUE_ADDRESS __allocator_t __alloc_;
+      __lane* __lanes_{nullptr};
+    };
+
+    template <class _RangeId>
+    struct __sender {
+      using _Range = stdexec::__t<_RangeId>;
+
+      template <class _Receiver>
+      using __receiver_t = stdexec::__t<__receiver<_RangeId, stdexec::__id<_Receiver>>>;
+
+      template <class _Receiver>
+      using __op_t = stdexec::__t<__operation<_RangeId, stdexec::__id<_Receiver>>>;
+
+      struct __t {
+        using __id = __sender;
+        using is_sender = void;
+
+        template <class _Range2>
+        __t(_Range2&& __range, std::size_t __max_concurrency) //
+          noexcept(__nothrow_decay_copyable<_Range2>)
+          : __range_((_Range2&&) __range)
+          , __max_concurrency_(__max_concurrency) {
+        }
+
+       private:
+        template <__decays_to<__t> _Self, receiver _Receiver>
+          requires sender_to<__child_sender_t<_Range&>, __receiver_t<_Receiver>>
+        friend __op_t<_Receiver> tag_invoke(connect_t, _Self&& __self, _Receiver __rcvr) {
+          return {
+            ((_Self&&) __self).__range_, (_Receiver&&) __rcvr, __self.__max_concurrency_};
+        }
+
+        template <__decays_to<__t> _Self, class _Env>
+        friend auto tag_invoke(get_completion_signatures_t, _Self&&, _Env)
+          -> dependent_completion_signatures<_Env>;
+
+        template <__decays_to<__t> _Self, class _Env>
+        friend auto tag_invoke(get_completion_signatures_t, _Self&&, _Env)
+          -> __completion_signatures_t<__child_sender_t<_Range&>, _Env>
+          requires true;
+
+        friend empty_env tag_invoke(get_env_t, const __t&) noexcept {
+          return {};
+        }
+
+        _Range __range_;
+        std::size_t __max_concurrency_;
+      };
+    };
+
+    struct when_all_range_t {
+      template <class _Range>
+      using __sender_t = __t<__sender<__id<__decay_t<_Range>>>>;
+
+      template <__range_of_senders _Range>
+      __sender_t<_Range> operator()(_Range&& __range) const
+        noexcept(__nothrow_decay_copyable<_Range>) {
+        return __sender_t<_Range>{(_Range&&) __range, std::numeric_limits<std::size_t>::max()};
+      }
+
+      // At most __max_concurrency children are in flight at any one time.
+      template <__range_of_senders _Range>
+      __sender_t<_Range> operator()(_Range&& __range, std::size_t __max_concurrency) const {
+        // Without a lane no child would ever be started.
+        if (__max_concurrency == 0) {
+          throw std::invalid_argument("when_all_range: max_concurrency must be positive");
+        }
+        return __sender_t<_Range>{(_Range&&) __range, __max_concurrency};
+      }
+    };
+  } // namespace __when_all_range
+
+  using __when_all_range::when_all_range_t;
+  inline constexpr when_all_range_t when_all_range{};
+} // namespace exec
@@ -18,6 +18,10 @@
 
 #include <stdexec/execution.hpp>
 
+#include "__detail/__sender_ranges.hpp"
+
+#include <stdexcept>
+
 namespace exec {
   namespace __when_any {
     using namespace stdexec;
@@ -272,6 +276,105 @@ namespace exec {
       };
     };
 
+    /////////////////////////////////////////////////////////////////////////////
+    // when_any over a runtime-sized range of senders of the same type. The
+    // child operation states are connected into a single allocation.
+    template <class _RangeId, class _ReceiverId>
+    struct __range_op {
+      using _Range = stdexec::__t<_RangeId>;
+      using _Receiver = stdexec::__t<_ReceiverId>;
+      using __child_t = __sender_ranges::__child_sender_t<_Range&>;
+
+      using __result_t = __result_type_t<env_of_t<_Receiver>, stdexec::__id<__child_t>>;
+      using __receiver_t = stdexec::__t<__receiver<_Receiver, __result_t>>;
+      using __op_base_t = __op_base<_Receiver, __result_t>;
+      using __child_op_t = connect_result_t<__child_t, __receiver_t>;
+      using __allocator_t =
+        decltype(__sender_ranges::__get_allocator(__declval<const env_of_t<_Receiver>&>()));
+
+      class __t : __op_base_t {
+       public:
+        template <class _Range2>
+        __t(_Range2&& __range, _Receiver&& __rcvr)
+          : __op_base_t{(_Receiver&&) __rcvr, static_cast<int>(std::ranges::size(__range))}
+          , __range_((_Range2&&) __range)
+          , __ops_{
+              __sender_ranges::__get_allocator(get_env(this->__receiver_)),
+              static_cast<std::size_t>(std::ranges::size(__range_)),
+              [this](std::size_t __i) {
+                return connect(
+                  std::ranges::iter_move(std::ranges::begin(__range_) + __i),
+                  __receiver_t{static_cast<__op_base_t*>(this)});
+              }} {
+        }
+
+       private:
+        _Range __range_;
+        __sender_ranges::__op_array<__child_op_t, __allocator_t> __ops_;
+
+        friend void tag_invoke(start_t, __t& __self) noexcept {
+          __self.__on_stop_.emplace(
+            get_stop_token(get_env(__self.__receiver_)),
+            __on_stop_requested{__self.__stop_source_});
+          if (__self.__stop_source_.stop_requested() || __self.__ops_.size() == 0) {
+            // Either we were asked to stop, or there is nothing that could
+            // produce a result.
+            __self.__on_stop_.reset();
+            set_stopped((_Receiver&&) __self.__receiver_);
+          } else {
+            // The last child to complete may destroy *this.
+            auto& __ops = __self.__ops_;
+            const std::size_t __size = __ops.size();
+            for (std::size_t __i = 0; __i < __size; ++__i) {
+              start(__ops[__i]);
+            }
+          }
+        }
+      };
+    };
+
+    template <class _RangeId>
+    struct __range_sender {
+      using _Range = stdexec::__t<_RangeId>;
+      using __child_t = __sender_ranges::__child_sender_t<_Range&>;
+
+      template <class _Receiver>
+      using __receiver_t = stdexec::__t<
+        __receiver<_Receiver, __result_type_t<env_of_t<_Receiver>, stdexec::__id<__child_t>>>>;
+
+      template <class _Receiver>
+      using __op_t = stdexec::__t<__range_op<_RangeId, __id<__decay_t<_Receiver>>>>;
+
+      class __t {
+       public:
+        using __id = __range_sender;
+        using is_sender = void;
+
+        template <class _Range2>
+        explicit __t(_Range2&& __range) noexcept(__nothrow_decay_copyable<_Range2>)
+          : __range_((_Range2&&) __range) {
+        }
+
+       private:
+        template <__decays_to<__t> _Self, receiver _Receiver>
+          requires sender_to<__child_t, __receiver_t<_Receiver>>
+        friend __op_t<_Receiver> tag_invoke(connect_t, _Self&& __self, _Receiver&& __rcvr) {
+          return __op_t<_Receiver>{((_Self&&) __self).__range_, (_Receiver&&) __rcvr};
+        }
+
+        template <__decays_to<__t> _Self, class _Env>
+        friend auto tag_invoke(get_completion_signatures_t, _Self&& __self, _Env __env) noexcept
+          -> dependent_completion_signatures<_Env>;
+
+        template <__decays_to<__t> _Self, class _Env>
+        friend auto tag_invoke(get_completion_signatures_t, _Self&& __self, _Env __env) noexcept
+          -> __completion_signatures_t<_Env, stdexec::__id<__child_t>>
+          requires true;
+
+        _Range __range_;
+      };
+    };
+
     struct __when_any_t {
       template <class... _Senders>
       using __sender_t = __t<__sender<__id<__decay_t<_Senders>>...>>;
@@ -282,10 +385,321 @@ namespace exec {
         noexcept((__nothrow_decay_copyable<_Senders> && ...)) {
         return __sender_t<_Senders...>((_Senders&&) __senders...);
       }
+
+      template <class _Range>
+      using __range_sender_t = __t<__range_sender<__id<__decay_t<_Range>>>>;
+
+      // Over a range of senders, the first child to complete wins. An empty
+      // range completes with set_stopped.
+      template <__sender_ranges::__range_of_senders _Range>
+        requires(!sender<_Range>)
+      __range_sender_t<_Range> operator()(_Range&& __range) const
+        noexcept(__nothrow_decay_copyable<_Range>) {
+        return __range_sender_t<_Range>((_Range&&) __range);
+      }
+    };
+
+    /////////////////////////////////////////////////////////////////////////////
+    // when_first_k: completes with the values of the first k children of a
+    // range to complete successfully, in the order in which they completed,
+    // and then stops the rest. If so many children fail that k successes are
+    // no longer possible, it completes with the first error, or with stopped
+    // if there was none.
+    template <class _Sender, class _Env>
+    using __first_k_element_t =
+      __sender_ranges::__element_of_t<_Sender, __env_t<_Env>>;
+
+    template <class _Sender, class _Env>
+    using __first_k_errors_variant_t = __minvoke<
+      __mconcat<__transform<__q<__decay_t>, __nullable_variant_t>>,
+      __types<std::exception_ptr>,
+      error_types_of_t<_Sender, __env_t<_Env>, __types>>;
+
+    template <class... _Errors>
+    using __as_decayed_errors = completion_signatures<set_error_t(__decay_t<_Errors>)...>;
+
+    template <class _Sender, class _Env>
+    using __first_k_completion_signatures_t = __concat_completion_signatures_t<
+      completion_signatures<
+        __sender_ranges::__set_value_sig_t<__first_k_element_t<_Sender, _Env>>,
+        set_error_t(std::exception_ptr),
+        set_stopped_t()>,
+      error_types_of_t<_Sender, __env_t<_Env>, __as_decayed_errors>>;
+
+    template <class _Receiver, class _Element, class _ErrorsVariant>
+    struct __first_k_op_base : __immovable {
+      using __on_stop = //
+        std::optional<typename stop_token_of_t< env_of_t<_Receiver>&>::template callback_type<
+          __on_stop_requested>>;
+
+      __first_k_op_base(_Receiver&& __receiver, std::size_t __k, std::size_t __n_senders)
+        : __k_{__k}
+        , __max_failures_{__n_senders - __k}
+        , __count_{__n_senders}
+        , __receiver_{(_Receiver&&) __receiver} {
+        if constexpr (!same_as<_Element, void>) {
+          __values_.resize(__k_);
+        }
+      }
+
+      std::size_t __k_;
+      std::size_t __max_failures_;
+
+      in_place_stop_source __stop_source_{};
+      __on_stop __on_stop_{};
+
+      // Successful children claim consecutive slots in __values_.
+      std::atomic<std::size_t> __n_claimed_{0};
+      // The number of values that were actually stored.
+      std::atomic<std::size_t> __n_stored_{0};
+      std::atomic<std::size_t> __n_failed_{0};
+      // If this hits true, we store the error
+      std::atomic<bool> __error_emplaced_{false};
+      // If this hits zero, we forward the result to the receiver
+      std::atomic<std::size_t> __count_;
+
+      _Receiver __receiver_;
+      STDEXEC_NO_UNIQUE_ADDRESS __sender_ranges::__values_t<_Element> __values_{};
+      _ErrorsVariant __error_{};
+
+      template <class... _Args>
+      void __set_value(_Args&&... __args) noexcept {
+        const std::size_t __slot = __n_claimed_.fetch_add(1, std::memory_order_relaxed);
+        if (__slot < __k_) {
+          try {
+            if constexpr (!same_as<_Element, void>) {
+              __sender_ranges::__store_value<_Element>(__values_, __slot, (_Args&&) __args...);
+            }
+            if (__n_stored_.fetch_add(1, std::memory_order_relaxed) + 1 == __k_) {
+              // We have what we came for. Stop pending operations.
+              __stop_source_.request_stop();
+            }
+          } catch (...) {
+            __set_error(std::current_exception());
+            return;
+          }
+        }
+        __arrive();
+      }
+
+      template <class _Error>
+      void __set_error(_Error&& __err) noexcept {
+        bool __expect = false;
+        if (__error_emplaced_.compare_exchange_strong(
+              __expect, true, std::memory_order_relaxed, std::memory_order_relaxed)) {
+          try {
+            __error_.template emplace<__decay_t<_Error>>((_Error&&) __err);
+          } catch (...) {
+            __error_.template emplace<std::exception_ptr>(std::current_exception());
+          }
+        }
+        __fail();
+      }
+
+      void __fail() noexcept {
+        if (__n_failed_.fetch_add(1, std::memory_order_relaxed) == __max_failures_) {
+          // Too few children remain to reach k. Stop pending operations.
+          __stop_source_.request_stop();
+        }
+        __arrive();
+      }
+
+      void __arrive() noexcept {
+        // make the stored values and error visible when __count_ goes from one to zero
+        if (__count_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+          __complete();
+        }
+      }
+
+      void __complete() noexcept {
+        __on_stop_.reset();
+        if (__n_stored_.load(std::memory_order_relaxed) == __k_) {
+          if constexpr (same_as<_Element, void>) {
+            set_value((_Receiver&&) __receiver_);
+          } else {
+            try {
+              set_value(
+                (_Receiver&&) __receiver_,
+                __sender_ranges::__take_values<_Element>(__values_, __k_));
+            } catch (...) {
+              set_error((_Receiver&&) __receiver_, std::current_exception());
+            }
+          }
+        } else if (
+          get_stop_token(get_env(__receiver_)).stop_requested()
+          || !__error_emplaced_.load(std::memory_order_relaxed)) {
+          set_stopped((_Receiver&&) __receiver_);
+        } else {
+          std::visit(
+            [this]<class _Error>(_Error& __err) noexcept {
+              if constexpr (!same_as<_Error, std::monostate>) {
+                set_error((_Receiver&&) __receiver_, (_Error&&) __err);
+              }
+            },
+            __error_);
+        }
+      }
+    };
+
+    template <class _Receiver, class _Element, class _ErrorsVariant>
+    struct __first_k_receiver {
+      class __t {
+       public:
+        using __id = __first_k_receiver;
+        using is_receiver = void;
+
+        explicit __t(__first_k_op_base<_Receiver, _Element, _ErrorsVariant>* __op) noexcept
+          : __op_{__op} {
+        }
+
+       private:
+        __first_k_op_base<_Receiver, _Element, _ErrorsVariant>* __op_;
+
+        template <same_as<set_value_t> _Tag, class... _Args>
+        friend void tag_invoke(_Tag, __t&& __self, _Args&&... __args) noexcept {
+          __self.__op_->__set_value((_Args&&) __args...);
+        }
+
+        template <same_as<set_error_t> _Tag, class _Error>
+        friend void tag_invoke(_Tag, __t&& __self, _Error&& __err) noexcept {
+          __self.__op_->__set_error((_Error&&) __err);
+        }
+
+        template <same_as<set_stopped_t> _Tag>
+        friend void tag_invoke(_Tag, __t&& __self) noexcept {
+          __self.__op_->__fail();
+        }
+
+        friend __env_t<env_of_t<_Receiver>> tag_invoke(get_env_t, const __t& __self) noexcept {
+          using __with_token = __with<get_stop_token_t, in_place_stop_token>;
+          auto __token = __with_token{__self.__op_->__stop_source_.get_token()};
+          return __make_env(get_env(__self.__op_->__receiver_), (__with_token&&) __token);
+        }
+      };
+    };
+
+    template <class _RangeId, class _ReceiverId>
+    struct __first_k_op {
+      using _Range = stdexec::__t<_RangeId>;
+      using _Receiver = stdexec::__t<_ReceiverId>;
+      using __child_t = __sender_ranges::__child_sender_t<_Range&>;
+
+      using __element_t = __first_k_element_t<__child_t, env_of_t<_Receiver>>;
+      using __errors_variant_t = __first_k_errors_variant_t<__child_t, env_of_t<_Receiver>>;
+      using __receiver_t =
+        stdexec::__t<__first_k_receiver<_Receiver, __element_t, __errors_variant_t>>;
+      using __op_base_t = __first_k_op_base<_Receiver, __element_t, __errors_variant_t>;
+      using __child_op_t = connect_result_t<__child_t, __receiver_t>;
+      using __allocator_t =
+        decltype(__sender_ranges::__get_allocator(__declval<const env_of_t<_Receiver>&>()));
+
+      class __t : __op_base_t {
+       public:
+        template <class _Range2>
+        __t(_Range2&& __range, _Receiver&& __rcvr, std::size_t __k)
+          : __op_base_t{
+            (_Receiver&&) __rcvr,
+            __k,
+            static_cast<std::size_t>(std::ranges::size(__range))}
+          , __range_((_Range2&&) __range)
+          , __ops_{
+              __sender_ranges::__get_allocator(get_env(this->__receiver_)),
+              static_cast<std::size_t>(std::ranges::size(__range_)),
+              [this](std::size_t __i) {
+                return connect(
+                  std::ranges::iter_move(std::ranges::begin(__range_) + __i),
+                  __receiver_t{static_cast<__op_base_t*>(this)});
+              }} {
+        }
+
+       private:
+        _Range __range_;
+        __sender_ranges::__op_array<__child_op_t, __allocator_t> __ops_;
+
+        friend void tag_invoke(start_t, __t& __self) noexcept {
+          __self.__on_stop_.emplace(
+            get_stop_token(get_env(__self.__receiver_)),
+            __on_stop_requested{__self.__stop_source_});
+          if (__self.__stop_source_.stop_requested()) {
+            __self.__on_stop_.reset();
+            set_stopped((_Receiver&&) __self.__receiver_);
+          } else if (__self.__k_ == 0) {
+            // There is nothing to wait for.
+            __self.__complete();
+          } else {
+            // The last child to complete may destroy *this.
+            auto& __ops = __self.__ops_;
+            const std::size_t __size = __ops.size();
+            for (std::size_t __i = 0; __i < __size; ++__i) {
+              start(__ops[__i]);
+            }
+          }
+        }
+      };
+    };
+
+    template <class _RangeId>
+    struct __first_k_sender {
+      using _Range = stdexec::__t<_RangeId>;
+      using __child_t = __sender_ranges::__child_sender_t<_Range&>;
+
+      template <class _Receiver>
+      using __op_t = stdexec::__t<__first_k_op<_RangeId, __id<__decay_t<_Receiver>>>>;
+
+      template <class _Receiver>
+      using __receiver_t =
+        typename __first_k_op<_RangeId, __id<__decay_t<_Receiver>>>::__receiver_t;
+
+      class __t {
+       public:
+        using __id = __first_k_sender;
+        using is_sender = void;
+
+        template <class _Range2>
+        __t(std::size_t __k, _Range2&& __range) noexcept(__nothrow_decay_copyable<_Range2>)
+          : __k_(__k)
+          , __range_((_Range2&&) __range) {
+        }
+
+       private:
+        template <__decays_to<__t> _Self, receiver _Receiver>
+          requires sender_to<__child_t, __receiver_t<_Receiver>>
+        friend __op_t<_Receiver> tag_invoke(connect_t, _Self&& __self, _Receiver&& __rcvr) {
+          return __op_t<_Receiver>{((_Self&&) __self).__range_, (_Receiver&&) __rcvr, __self.__k_};
+        }
+
+        template <__decays_to<__t> _Self, class _Env>
+        friend auto tag_invoke(get_completion_signatures_t, _Self&& __self, _Env __env) noexcept
+          -> dependent_completion_signatures<_Env>;
+
+        template <__decays_to<__t> _Self, class _Env>
+        friend auto tag_invoke(get_completion_signatures_t, _Self&& __self, _Env __env) noexcept
+          -> __first_k_completion_signatures_t<__child_t, _Env>
+          requires true;
+
+        std::size_t __k_;
+        _Range __range_;
+      };
+    };
+
+    struct __when_first_k_t {
+      template <class _Range>
+      using __sender_t = __t<__first_k_sender<__id<__decay_t<_Range>>>>;
+
+      template <__sender_ranges::__range_of_senders _Range>
+      __sender_t<_Range> operator()(std::size_t __k, _Range&& __range) const {
+        // k successes out of fewer children could never be reached.
+        if (__k > static_cast<std::size_t>(std::ranges::size(__range))) {
+          throw std::invalid_argument("when_first_k: k exceeds the number of senders");
+        }
+        return __sender_t<_Range>(__k, (_Range&&) __range);
+      }
     };
 
     inline constexpr __when_any_t when_any{};
+    inline constexpr __when_first_k_t when_first_k{};
   } // namespace __when_any
 
   using __when_any::when_any;
+  using __when_any::when_first_k;
 }
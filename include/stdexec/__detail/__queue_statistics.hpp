@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "__config.hpp"
+
+namespace stdexec {
+  // The recording side of the optional queue statistics of the execution contexts; see
+  // exec/queue_statistics.hpp for the reading side.
+  namespace __queue_stats {
+    // Log-linear buckets as in HdrHistogram: values below 2 * __sub_buckets have a bucket each,
+    // and every power of two above that is split into __sub_buckets buckets, so a bucket's
+    // values are within 1/__sub_buckets of each other.
+    inline constexpr std::uint32_t __sub_bucket_bits = 5;
+    inline constexpr std::uint64_t __sub_buckets = std::uint64_t{1} << __sub_bucket_bits;
+    inline constexpr std::size_t __bucket_count = (64 - __sub_bucket_bits + 1) * __sub_buckets;
+
+    constexpr std::size_t __bucket_index(std::uint64_t __value) noexcept {
+      if (__value < __sub_buckets) {
+        return static_cast<std::size_t>(__value);
+      }
+      const std::uint32_t __exponent = static_cast<std::uint32_t>(std::bit_width(__value)) - 1;
+      const std::uint32_t __shift = __exponent - __sub_bucket_bits;
+      return static_cast<std::size_t>(
+        (__shift + 1) * __sub_buckets + ((__value >> __shift) - __sub_buckets));
+    }
+
+    // The largest value that falls into the bucket.
+    constexpr std::uint64_t __bucket_upper_bound(std::size_t __index) noexcept {
+      const std::uint64_t __octave = __index / __sub_buckets;
+      if (__octave <= 1) {
+        return __index;
+      }
+      const std::uint64_t __shift = __octave - 1;
+      const std::uint64_t __lower = (__index % __sub_buckets + __sub_buckets) << __shift;
+      return __lower + ((std::uint64_t{1} << __shift) - 1);
+    }
+
+    struct __histogram {
+      std::atomic<std::uint64_t> __counts_[__bucket_count]{};
+
+      void __record(std::uint64_t __value_ns) noexcept {
+        __counts_[__bucket_index(__value_ns)].fetch_add(1, std::memory_order_relaxed);
+      }
+    };
+
+    // The histograms of one worker thread.
+    struct __recorder {
+      __histogram __queue_delay_;
+      __histogram __service_time_;
+    };
+
+    inline std::uint64_t __now_ns() noexcept {
+      return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                          std::chrono::steady_clock::now().time_since_epoch())
+                                          .count());
+    }
+
+    // Runs a task stamped with its enqueue time and records how long it waited and ran.
+    // Tasks without a stamp were not enqueued through the instrumented path and are not
+    // recorded. The task may be gone once it has run, so the stamp is read first.
+    template <class _Run>
+    void __run_recorded(__recorder& __rec, std::uint64_t __enqueued_ns, _Run __run) noexcept {
+      if (__enqueued_ns == 0) {
+        __run();
+        return;
+      }
+      const std::uint64_t __start_ns = __now_ns();
+      __run();
+      const std::uint64_t __end_ns = __now_ns();
+      __rec.__queue_delay_.__record(__start_ns - __enqueued_ns);
+      __rec.__service_time_.__record(__end_ns - __start_ns);
+    }
+  } // namespace __queue_stats
+} // namespace stdexec
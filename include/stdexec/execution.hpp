@@ -30,6 +30,7 @@
 
 #include "__detail/__intrusive_ptr.hpp"
 #include "__detail/__meta.hpp"
+#include "__detail/__queue_statistics.hpp"
 #include "__detail/__scope.hpp"
 #include "functional.hpp"
 #include "concepts.hpp"
@@ -2351,6 +2352,14 @@ namespace stdexec {
 
   /////////////////////////////////////////////////////////////////////////////
   // [execution.senders.factories]
+  // Senders whose operations always complete synchronously from within
+  // start() can advertise it with a nested __completes_inline type. Adaptors
+  // use this to drop synchronization that is only needed when child operations
+  // may complete concurrently.
+  template <class _Sender>
+  concept __completes_inline = //
+    requires { typename __decay_t<_Sender>::__completes_inline; };
+
   namespace __just {
     template <class _Tag, class... _Ts>
     using __completion_signatures_ = completion_signatures<_Tag(_Ts...)>;
@@ -2382,6 +2391,7 @@ namespace stdexec {
       struct __t {
         using __id = __basic_sender;
         using is_sender = void;
+        using __completes_inline = void;
         using completion_signatures = __completion_signatures_<_Tag, _Ts...>;
 
         std::tuple<_Ts...> __vals_;
@@ -4577,6 +4587,9 @@ namespace stdexec {
         __task* __tail_;
       };
 
+      // Stamped when the task is enqueued, if the loop keeps queue statistics.
+      std::uint64_t __enqueued_ns_ = 0;
+
       void __execute() noexcept {
         (*__execute_)(this);
       }
@@ -4719,6 +4732,19 @@ namespace stdexec {
 
       void finish();
 
+      // NOT TO SPEC: records how long tasks wait in the queue and how long they run, from
+      // now on. Not thread-safe with itself. See exec/queue_statistics.hpp.
+      void __enable_queue_statistics() {
+        if (!__stats_storage_) {
+          __stats_storage_ = std::make_unique<__queue_stats::__recorder>();
+          __stats_.store(__stats_storage_.get(), std::memory_order_release);
+        }
+      }
+
+      const __queue_stats::__recorder* __queue_statistics() const noexcept {
+        return __stats_.load(std::memory_order_acquire);
+      }
+
      private:
       void __push_back_(__task* __task);
       __task* __pop_front_();
@@ -4727,6 +4753,8 @@ namespace stdexec {
       std::condition_variable __cv_;
       __task __head_{.__tail_ = &__head_};
       bool __stop_ = false;
+      std::unique_ptr<__queue_stats::__recorder> __stats_storage_;
+      std::atomic<__queue_stats::__recorder*> __stats_{nullptr};
     };
 
     template <class _ReceiverId>
@@ -4740,7 +4768,12 @@ namespace stdexec {
 
     inline void run_loop::run() {
       for (__task* __task; (__task = __pop_front_()) != &__head_;) {
-        __task->__execute();
+        if (__queue_stats::__recorder* __stats = __stats_.load(std::memory_order_acquire)) {
+          __queue_stats::__run_recorded(
+            *__stats, __task->__enqueued_ns_, [__task]() noexcept { __task->__execute(); });
+        } else {
+          __task->__execute();
+        }
       }
     }
 
@@ -4751,6 +4784,9 @@ namespace stdexec {
     }
 
     inline void run_loop::__push_back_(__task* __task) {
+      if (__stats_.load(std::memory_order_relaxed)) {
+        __task->__enqueued_ns_ = __queue_stats::__now_ns();
+      }
       std::unique_lock __lock{__mutex_};
       __task->__next_ = &__head_;
       __head_.__tail_ = __head_.__tail_->__next_ = __task;
@@ -5458,6 +5494,23 @@ namespace stdexec {
       }
     };
 
+    // Used in place of an in_place_stop_source when every child operation
+    // completes inline from start(). Nobody can observe a stop request by the
+    // time one would be made, so there is nothing to do.
+    struct __inline_stop_source {
+      in_place_stop_token get_token() const noexcept {
+        return {};
+      }
+
+      bool stop_requested() const noexcept {
+        return false;
+      }
+
+      bool request_stop() noexcept {
+        return false;
+      }
+    };
+
     template <class _EnvId>
     struct __env {
       using _Env = stdexec::__t<_EnvId>;
@@ -5579,9 +5632,72 @@ namespace stdexec {
         __values);
     }
 
-    template <class _ReceiverId, class _ValuesTuple, class _ErrorsVariant>
+    // When _Inline is true, all the child operations are known to complete
+    // synchronously within start(), so the barrier and the state need not be
+    // atomic, and there is no stop source to forward stop requests through.
+    template <class _ReceiverId, class _ValuesTuple, class _ErrorsVariant, bool _Inline>
     struct __operation_base : __immovable {
       using _Receiver = stdexec::__t<_ReceiverId>;
+      using __stop_token_t = stop_token_of_t<env_of_t<_Receiver>&>;
+
+      static constexpr bool __needs_stop_callback =
+        !_Inline && !unstoppable_token<__stop_token_t>;
+
+      using __count_t = __if_c<_Inline, std::size_t, std::atomic<std::size_t>>;
+      using __state_holder_t = __if_c<_Inline, __state_t, std::atomic<__state_t>>;
+      using __stop_source_t = __if_c<_Inline, __inline_stop_source, in_place_stop_source>;
+      using __on_stop_t = __if_c<
+        __needs_stop_callback,
+        std::optional<typename __stop_token_t::template callback_type<__on_stop_requested>>,
+        __ignore>;
+
+      // Registers the stop callback (if one is needed) and reports whether
+      // stop has already been requested.
+      bool __start_stop_callback() noexcept {
+        if constexpr (_Inline) {
+          return get_stop_token(get_env(__recvr_)).stop_requested();
+        } else {
+          if constexpr (__needs_stop_callback) {
+            __on_stop_.emplace(
+              get_stop_token(get_env(__recvr_)), __on_stop_requested{__stop_source_});
+          }
+          return __stop_source_.stop_requested();
+        }
+      }
+
+      __state_t __get_state() const noexcept {
+        if constexpr (_Inline) {
+          return __state_;
+        } else {
+          return __state_.load(std::memory_order_relaxed);
+        }
+      }
+
+      // Returns true if this call moved the operation into the error state.
+      bool __try_set_error_state() noexcept {
+        if constexpr (_Inline) {
+          return __error != std::exchange(__state_, __error);
+        } else {
+          // TODO: What memory orderings are actually needed here?
+          return __error != __state_.exchange(__error);
+        }
+      }
+
+      // Transition to the "stopped" state if and only if we're in the
+      // "started" state. (If this fails, it's because we're in an
+      // error state, which trumps cancellation.)
+      bool __try_set_stopped_state() noexcept {
+        if constexpr (_Inline) {
+          if (__state_ != __started) {
+            return false;
+          }
+          __state_ = __stopped;
+          return true;
+        } else {
+          __state_t __expected = __started;
+          return __state_.compare_exchange_strong(__expected, __stopped);
+        }
+      }
 
       void __arrive() noexcept {
         if (0 == --__count_) {
@@ -5590,10 +5706,12 @@ namespace stdexec {
       }
 
       void __complete() noexcept {
-        // Stop callback is no longer needed. Destroy it.
-        __on_stop_.reset();
+        if constexpr (__needs_stop_callback) {
+          // Stop callback is no longer needed. Destroy it.
+          __on_stop_.reset();
+        }
         // All child operations have completed and arrived at the barrier.
-        switch (__state_.load(std::memory_order_relaxed)) {
+        switch (__get_state()) {
         case __started:
           if constexpr (!same_as<_ValuesTuple, __ignore>) {
             // All child operations completed successfully:
@@ -5614,18 +5732,21 @@ namespace stdexec {
       }
 
       _Receiver __recvr_;
-      std::atomic<std::size_t> __count_;
-      in_place_stop_source __stop_source_{};
+      __count_t __count_;
+      STDEXEC_NO_UNIQUE_ADDRESS __stop_source_t __stop_source_{};
       // Could be non-atomic here and atomic_ref everywhere except __completion_fn
-      std::atomic<__state_t> __state_{__started};
+      __state_holder_t __state_{__started};
       _ErrorsVariant __errors_{};
       STDEXEC_NO_UNIQUE_ADDRESS _ValuesTuple __values_{};
-      std::optional<
-        typename stop_token_of_t<env_of_t<_Receiver>&>::template callback_type<__on_stop_requested>>
-        __on_stop_{};
+      STDEXEC_NO_UNIQUE_ADDRESS __on_stop_t __on_stop_{};
     };
 
-    template <std::size_t _Index, class _ReceiverId, class _ValuesTuple, class _ErrorsVariant>
+    template <
+      std::size_t _Index,
+      class _ReceiverId,
+      class _ValuesTuple,
+      class _ErrorsVariant,
+      bool _Inline>
     struct __receiver {
       using _Receiver = stdexec::__t<_ReceiverId>;
       template <class _Tuple>
@@ -5637,8 +5758,7 @@ namespace stdexec {
 
         template <class _Error>
         void __set_error(_Error&& __err) noexcept {
-          // TODO: What memory orderings are actually needed here?
-          if (__error != __op_state_->__state_.exchange(__error)) {
+          if (__op_state_->__try_set_error_state()) {
             __op_state_->__stop_source_.request_stop();
             // We won the race, free to write the error into the operation
             // state without worry.
@@ -5664,7 +5784,7 @@ namespace stdexec {
               "One of the senders in this when_all() is fibbing about what types it sends");
             // We only need to bother recording the completion values
             // if we're not already in the "error" or "stopped" state.
-            if (__self.__op_state_->__state_ == __started) {
+            if (__self.__op_state_->__get_state() == __started) {
               if constexpr ((__nothrow_decay_copyable<_Values> && ...)) {
                 std::get<_Index>(__self.__op_state_->__values_).emplace((_Values&&) __vals...);
               } else {
@@ -5691,11 +5811,7 @@ namespace stdexec {
         template <same_as<set_stopped_t> _Tag>
           requires receiver_of<_Receiver, completion_signatures<_Tag()>>
         friend void tag_invoke(_Tag, __t&& __self) noexcept {
-          __state_t __expected = __started;
-          // Transition to the "stopped" state if and only if we're in the
-          // "started" state. (If this fails, it's because we're in an
-          // error state, which trumps cancellation.)
-          if (__self.__op_state_->__state_.compare_exchange_strong(__expected, __stopped)) {
+          if (__self.__op_state_->__try_set_stopped_state()) {
             __self.__op_state_->__stop_source_.request_stop();
           }
           __self.__op_state_->__arrive();
@@ -5707,7 +5823,7 @@ namespace stdexec {
             __self.__op_state_->__stop_source_.get_token()};
         }
 
-        __operation_base<_ReceiverId, _ValuesTuple, _ErrorsVariant>* __op_state_;
+        __operation_base<_ReceiverId, _ValuesTuple, _ErrorsVariant, _Inline>* __op_state_;
       };
     };
 
@@ -5752,12 +5868,19 @@ namespace stdexec {
       using typename _Traits::__values_tuple;
       using typename _Traits::__errors_variant;
 
+      // All the children complete synchronously within start():
+      static constexpr bool __all_inline = (__completes_inline<_Senders> && ...);
+
       template <std::size_t _Index>
-      using __receiver =
-        __t< __when_all::__receiver< _Index, __id<_Receiver>, __values_tuple, __errors_variant>>;
+      using __receiver = __t<__when_all::__receiver<
+        _Index,
+        __id<_Receiver>,
+        __values_tuple,
+        __errors_variant,
+        __all_inline>>;
 
-      using __operation_base =
-        __when_all::__operation_base<__id<_Receiver>, __values_tuple, __errors_variant>;
+      using __operation_base = __when_all::
+        __operation_base<__id<_Receiver>, __values_tuple, __errors_variant, __all_inline>;
 
       template <class _Sender, class _Index>
       using __op_state = connect_result_t<_Sender, __receiver<__v<_Index>>>;
@@ -5809,9 +5932,7 @@ namespace stdexec {
 
         friend void tag_invoke(start_t, __t& __self) noexcept {
           // register stop callback:
-          __self.__on_stop_.emplace(
-            get_stop_token(get_env(__self.__recvr_)), __on_stop_requested{__self.__stop_source_});
-          if (__self.__stop_source_.stop_requested()) {
+          if (__self.__start_stop_callback()) {
             // Stop has already been requested. Don't bother starting
             // the child operations.
             stdexec::set_stopped((_Receiver&&) __self.__recvr_);
@@ -5998,6 +6119,7 @@ namespace stdexec {
       using __t = __sender;
       using __id = __sender;
       using is_sender = void;
+      using __completes_inline = void;
 
       template <class _Env>
         requires __callable<_Tag, _Env>
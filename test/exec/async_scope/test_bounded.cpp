@@ -0,0 +1,161 @@
+#include <catch2/catch.hpp>
+#include <exec/async_scope.hpp>
+#include <exec/env.hpp>
+#include <exec/static_thread_pool.hpp>
+#include "test_common/schedulers.hpp"
+#include "test_common/receivers.hpp"
+
+#include <atomic>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+namespace ex = stdexec;
+using exec::bounded_async_scope;
+using stdexec::sync_wait;
+
+namespace {
+  bounded_async_scope::reservation acquire(bounded_async_scope& scope) {
+    auto [reservation] = sync_wait(scope.acquire()).value();
+    return std::move(reservation);
+  }
+}
+
+TEST_CASE("bounded_async_scope rejects a limit of zero", "[async_scope][bounded]") {
+  CHECK_THROWS_AS(bounded_async_scope{0}, std::invalid_argument);
+}
+
+TEST_CASE("bounded_async_scope acquire completes below the limit", "[async_scope][bounded]") {
+  bounded_async_scope scope{2};
+  bool executed{false};
+  auto reservation = acquire(scope);
+  REQUIRE(reservation);
+  scope.spawn(ex::just() | ex::then([&] { executed = true; }), std::move(reservation));
+  REQUIRE_FALSE(reservation);
+  REQUIRE(executed);
+  sync_wait(scope.on_empty());
+}
+
+TEST_CASE("bounded_async_scope acquire waits while the scope is full", "[async_scope][bounded]") {
+  impulse_scheduler sch;
+  bounded_async_scope scope{2};
+  scope.spawn(ex::on(sch, ex::just()));
+  scope.spawn(ex::on(sch, ex::just()));
+
+  std::optional<bounded_async_scope::reservation> reservation;
+  auto op = ex::connect(
+    scope.acquire() | ex::then([&](bounded_async_scope::reservation r) {
+      reservation.emplace(std::move(r));
+    }),
+    expect_void_receiver{});
+  ex::start(op);
+  REQUIRE_FALSE(reservation);
+
+  sch.start_next();
+  REQUIRE(reservation);
+  // The reserved slot is taken over by the nested operation.
+  scope.spawn(ex::on(sch, ex::just()), std::move(*reservation));
+  sch.start_next();
+  sch.start_next();
+  sync_wait(scope.on_empty());
+}
+
+TEST_CASE("bounded_async_scope acquire can be cancelled", "[async_scope][bounded]") {
+  impulse_scheduler sch;
+  bounded_async_scope scope{1};
+  scope.spawn(ex::on(sch, ex::just()));
+
+  ex::in_place_stop_source stop_source;
+  auto op = ex::connect(
+    exec::write(scope.acquire(), exec::with(ex::get_stop_token, stop_source.get_token())),
+    expect_stopped_receiver{});
+  ex::start(op);
+  stop_source.request_stop();
+
+  // The freed slot is not handed to the cancelled waiter.
+  sch.start_next();
+  scope.spawn(ex::just(), acquire(scope));
+  sync_wait(scope.on_empty());
+}
+
+TEST_CASE("bounded_async_scope acquire of a stopped receiver", "[async_scope][bounded]") {
+  bounded_async_scope scope{1};
+  ex::in_place_stop_source stop_source;
+  stop_source.request_stop();
+  auto op = ex::connect(
+    exec::write(scope.acquire(), exec::with(ex::get_stop_token, stop_source.get_token())),
+    expect_stopped_receiver{});
+  ex::start(op);
+}
+
+TEST_CASE("bounded_async_scope gives back an abandoned reservation", "[async_scope][bounded]") {
+  bounded_async_scope scope{1};
+  {
+    auto reservation = acquire(scope);
+    // The producer gives up without nesting anything.
+  }
+  auto reservation = acquire(scope);
+  reservation.release();
+  REQUIRE_FALSE(reservation);
+
+  // A nest sender that is never started gives its reservation back too.
+  {
+    auto nested = scope.nest(ex::just(), acquire(scope));
+  }
+
+  // The slot is handed to a waiting acquire().
+  auto held = acquire(scope);
+  bool acquired{false};
+  auto op = ex::connect(
+    scope.acquire() | ex::then([&](bounded_async_scope::reservation) { acquired = true; }),
+    expect_void_receiver{});
+  ex::start(op);
+  REQUIRE_FALSE(acquired);
+  held.release();
+  REQUIRE(acquired);
+  sync_wait(scope.on_empty());
+}
+
+TEST_CASE(
+  "bounded_async_scope reservations are not consumed by other nested operations",
+  "[async_scope][bounded]") {
+  impulse_scheduler sch;
+  bounded_async_scope scope{1};
+  auto reservation = acquire(scope);
+  // An operation nested without a reservation counts against the limit on its own.
+  scope.spawn(ex::on(sch, ex::just()));
+  bool acquired{false};
+  auto op = ex::connect(
+    scope.acquire() | ex::then([&](bounded_async_scope::reservation) { acquired = true; }),
+    expect_void_receiver{});
+  ex::start(op);
+  sch.start_next();
+  REQUIRE_FALSE(acquired);
+  reservation.release();
+  REQUIRE(acquired);
+  sync_wait(scope.on_empty());
+}
+
+TEST_CASE(
+  "bounded_async_scope never exceeds the limit under concurrent work",
+  "[async_scope][bounded]") {
+  exec::static_thread_pool pool{4};
+  auto sch = pool.get_scheduler();
+  constexpr int max_in_flight = 3;
+  std::atomic<int> in_flight{0};
+  std::atomic<int> peak{0};
+  auto work = [&] {
+    int now = in_flight.fetch_add(1) + 1;
+    int prev = peak.load();
+    while (prev < now && !peak.compare_exchange_weak(prev, now)) {
+    }
+    in_flight.fetch_sub(1);
+  };
+  bounded_async_scope scope{max_in_flight};
+  for (int i = 0; i < 500; ++i) {
+    scope.spawn(ex::schedule(sch) | ex::then(work), acquire(scope));
+  }
+  sync_wait(scope.on_empty());
+  REQUIRE(peak.load() <= max_in_flight);
+  REQUIRE(in_flight.load() == 0);
+}
@@ -1,5 +1,6 @@
 #include <catch2/catch.hpp>
 #include <exec/async_scope.hpp>
+#include <exec/static_thread_pool.hpp>
 #include "test_common/schedulers.hpp"
 #include "test_common/receivers.hpp"
 
@@ -173,3 +174,20 @@ TEST_CASE(
   REQUIRE(is_empty2);
 }
 #endif
+
+TEST_CASE("empty completes once concurrently spawned work is done", "[async_scope][empty]") {
+  exec::static_thread_pool pool{4};
+  auto sch = pool.get_scheduler();
+  for (int iteration = 0; iteration < 100; ++iteration) {
+    std::atomic<int> counter{0};
+    auto work = [&] {
+      counter.fetch_add(1, std::memory_order_relaxed);
+    };
+    async_scope scope;
+    for (int i = 0; i < 100; ++i) {
+      scope.spawn(ex::schedule(sch) | ex::then(work));
+    }
+    sync_wait(ex::when_all(scope.on_empty(), scope.on_empty()));
+    REQUIRE(counter.load() == 100);
+  }
+}
@@ -0,0 +1,105 @@
+#include <catch2/catch.hpp>
+#include <exec/async_scope.hpp>
+#include <exec/static_thread_pool.hpp>
+#include "test_common/schedulers.hpp"
+#include "test_common/receivers.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace ex = stdexec;
+using exec::sharded_async_scope;
+using stdexec::sync_wait;
+
+TEST_CASE("sharded_async_scope nests senders like async_scope", "[async_scope][sharded]") {
+  sharded_async_scope scope{3};
+  bool executed{false};
+  sync_wait(scope.nest(ex::just() | ex::then([&] { executed = true; })));
+  REQUIRE(executed);
+  sync_wait(scope.on_empty());
+}
+
+TEST_CASE("sharded_async_scope empty waits for work on every shard", "[async_scope][sharded]") {
+  impulse_scheduler sch;
+  sharded_async_scope scope{4};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&] { scope.spawn(ex::on(sch, ex::just())); });
+  }
+  for (auto& thread: threads) {
+    thread.join();
+  }
+
+  bool is_empty{false};
+  auto op = ex::connect(
+    scope.on_empty() | ex::then([&] { is_empty = true; }), expect_void_receiver{});
+  ex::start(op);
+  for (int i = 0; i < 4; ++i) {
+    REQUIRE_FALSE(is_empty);
+    sch.start_next();
+  }
+  REQUIRE(is_empty);
+}
+
+TEST_CASE(
+  "sharded_async_scope empty completes after concurrently spawned work",
+  "[async_scope][sharded]") {
+  exec::static_thread_pool pool{4};
+  auto sch = pool.get_scheduler();
+  for (int iteration = 0; iteration < 50; ++iteration) {
+    std::atomic<int> counter{0};
+    auto work = [&] {
+      counter.fetch_add(1, std::memory_order_relaxed);
+    };
+    sharded_async_scope scope;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([&] {
+        for (int i = 0; i < 50; ++i) {
+          scope.spawn(ex::schedule(sch) | ex::then(work));
+        }
+      });
+    }
+    for (auto& thread: threads) {
+      thread.join();
+    }
+    sync_wait(scope.on_empty());
+    REQUIRE(counter.load() == 200);
+  }
+}
+
+TEST_CASE("sharded_async_scope request_stop reaches every shard", "[async_scope][sharded]") {
+  exec::static_thread_pool pool{4};
+  auto sch = pool.get_scheduler();
+  std::atomic<int> stopped{0};
+  auto wait_for_stop = [&](ex::in_place_stop_token token) {
+    while (!token.stop_requested()) {
+      std::this_thread::yield();
+    }
+    stopped.fetch_add(1, std::memory_order_relaxed);
+  };
+  // Work that has not been picked up by the pool yet completes with set_stopped instead.
+  auto on_stopped = [&] {
+    stopped.fetch_add(1, std::memory_order_relaxed);
+  };
+  sharded_async_scope scope{4};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&] {
+      for (int i = 0; i < 4; ++i) {
+        scope.spawn(
+          ex::schedule(sch)                                            //
+          | ex::let_value([] { return ex::read(ex::get_stop_token); }) //
+          | ex::then(wait_for_stop)                                    //
+          | ex::upon_stopped(on_stopped));
+      }
+    });
+  }
+  for (auto& thread: threads) {
+    thread.join();
+  }
+  scope.request_stop();
+  sync_wait(scope.on_empty());
+  REQUIRE(stopped.load() == 16);
+}
@@ -1,6 +1,7 @@
 #include <catch2/catch.hpp>
 #include <exec/async_scope.hpp>
 #include <exec/env.hpp>
+#include <exec/static_thread_pool.hpp>
 #include "test_common/schedulers.hpp"
 #include "test_common/receivers.hpp"
 #include "test_common/type_helpers.hpp"
@@ -440,3 +441,21 @@ TEST_CASE(
   // ex::start(op);
   expect_empty(scope);
 }
+
+TEST_CASE(
+  "spawn_future races completion against consuming or dropping the future",
+  "[async_scope][spawn_future]") {
+  exec::static_thread_pool pool{4};
+  auto sch = pool.get_scheduler();
+  async_scope scope;
+  for (int i = 0; i < 1000; ++i) {
+    auto fut = scope.spawn_future(ex::schedule(sch) | ex::then([i] { return i; }));
+    if (i % 2 == 0) {
+      auto [result] = sync_wait(std::move(fut)).value();
+      REQUIRE(result == i);
+    }
+    // odd iterations drop the future while the work may still be running
+  }
+  sync_wait(scope.on_empty());
+  expect_empty(scope);
+}
@@ -24,6 +24,7 @@
 
 #include <catch2/catch.hpp>
 
+#include <array>
 
 using namespace stdexec;
 using namespace exec;
@@ -387,6 +388,115 @@ TEST_CASE(
   start(do_check);
 }
 
+struct allocation_counts {
+  int allocations{0};
+  int deallocations{0};
+};
+
+template <class T>
+struct counting_allocator {
+  using value_type = T;
+  allocation_counts* counts_;
+
+  explicit counting_allocator(allocation_counts* counts) noexcept
+    : counts_{counts} {
+  }
+
+  template <class U>
+  counting_allocator(const counting_allocator<U>& other) noexcept
+    : counts_{other.counts_} {
+  }
+
+  T* allocate(std::size_t n) {
+    ++counts_->allocations;
+    return std::allocator<T>{}.allocate(n);
+  }
+
+  void deallocate(T* p, std::size_t n) noexcept {
+    ++counts_->deallocations;
+    std::allocator<T>{}.deallocate(p, n);
+  }
+
+  friend bool operator==(const counting_allocator&, const counting_allocator&) = default;
+};
+
+struct allocator_env {
+  allocation_counts* counts_;
+
+  friend counting_allocator<std::byte>
+    tag_invoke(get_allocator_t, const allocator_env& e) noexcept {
+    return counting_allocator<std::byte>{e.counts_};
+  }
+};
+
+struct allocating_receiver {
+  allocation_counts* counts_;
+  int* value_;
+
+  friend void tag_invoke(set_value_t, allocating_receiver&& r, int value) noexcept {
+    *r.value_ = value;
+  }
+
+  friend void tag_invoke(set_stopped_t, allocating_receiver&&) noexcept {
+  }
+
+  friend allocator_env tag_invoke(get_env_t, const allocating_receiver& r) noexcept {
+    return {r.counts_};
+  }
+};
+
+TEST_CASE("any_sender stores small operation states inline", "[types][any_sender]") {
+  allocation_counts counts{};
+  int value = 0;
+  any_sender_of<set_value_t(int), set_stopped_t()> sender = just(42);
+  {
+    auto op = connect(std::move(sender), allocating_receiver{&counts, &value});
+    start(op);
+  }
+  CHECK(value == 42);
+  CHECK(counts.allocations == 0);
+  CHECK(counts.deallocations == 0);
+}
+
+TEST_CASE(
+  "any_sender allocates large operation states with the receiver's allocator",
+  "[types][any_sender]") {
+  allocation_counts counts{};
+  int value = 0;
+  auto big = [payload = std::array<char, 256>{}](int v) noexcept {
+    return v + payload[0];
+  };
+  any_sender_of<set_value_t(int), set_stopped_t()> sender = just(42) | then(big);
+  {
+    auto op = connect(std::move(sender), allocating_receiver{&counts, &value});
+    CHECK(counts.allocations == 1);
+    start(op);
+  }
+  CHECK(value == 42);
+  CHECK(counts.deallocations == 1);
+}
+
+TEST_CASE("any_sender with configured inline storage does not allocate", "[types][any_sender]") {
+  using Sigs = completion_signatures<set_value_t(int), set_stopped_t()>;
+  using storage = any_sender_storage<512, alignof(std::max_align_t), 512>;
+  using big_sender = any_receiver_ref<Sigs>::basic_any_sender<storage>;
+  static_assert(sizeof(big_sender) > 512);
+
+  allocation_counts counts{};
+  int value = 0;
+  auto big = [payload = std::array<char, 256>{}](int v) noexcept {
+    return v + payload[0];
+  };
+  big_sender sender = just(42) | then(big);
+  {
+    auto op = connect(std::move(sender), allocating_receiver{&counts, &value});
+    start(op);
+  }
+  CHECK(value == 42);
+  CHECK(counts.allocations == 0);
+  CHECK(counts.deallocations == 0);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 //                                                                any_scheduler
 
@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch2/catch.hpp>
+#include <exec/async_mutex.hpp>
+#include <exec/async_scope.hpp>
+#include <exec/env.hpp>
+#include <exec/static_thread_pool.hpp>
+#include <exec/task.hpp>
+#include <test_common/receivers.hpp>
+#include <test_common/type_helpers.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace ex = stdexec;
+
+TEST_CASE("async_semaphore acquire advertises its completions", "[async_semaphore]") {
+  exec::async_semaphore semaphore{1};
+  check_val_types<type_array<type_array<>>>(semaphore.acquire());
+  check_sends_stopped<true>(semaphore.acquire());
+}
+
+TEST_CASE("async_semaphore acquire completes inline while permits are available",
+          "[async_semaphore]") {
+  exec::async_semaphore semaphore{3};
+  ex::sync_wait(semaphore.acquire(2));
+  REQUIRE(semaphore.try_acquire());
+  REQUIRE_FALSE(semaphore.try_acquire());
+  semaphore.release(3);
+  REQUIRE(semaphore.try_acquire(3));
+  semaphore.release(3);
+}
+
+TEST_CASE("async_semaphore release resumes waiting operations in order", "[async_semaphore]") {
+  exec::async_semaphore semaphore{0};
+  std::vector<int> order;
+  auto first = ex::connect(
+    semaphore.acquire(2) | ex::then([&] { order.push_back(1); }), expect_void_receiver{});
+  auto second = ex::connect(
+    semaphore.acquire(1) | ex::then([&] { order.push_back(2); }), expect_void_receiver{});
+  ex::start(first);
+  ex::start(second);
+
+  // The second operation waits behind the first even though a permit would satisfy it.
+  semaphore.release(1);
+  REQUIRE(order.empty());
+  REQUIRE_FALSE(semaphore.try_acquire());
+  semaphore.release(2);
+  REQUIRE(order == std::vector{1, 2});
+  REQUIRE_FALSE(semaphore.try_acquire());
+}
+
+TEST_CASE("async_semaphore waiting operations can be cancelled", "[async_semaphore]") {
+  exec::async_semaphore semaphore{1};
+  ex::in_place_stop_source stop_source;
+  bool acquired = false;
+  auto large = ex::connect(
+    exec::write(semaphore.acquire(2), exec::with(ex::get_stop_token, stop_source.get_token())),
+    expect_stopped_receiver{});
+  auto small = ex::connect(
+    semaphore.acquire(1) | ex::then([&] { acquired = true; }), expect_void_receiver{});
+  ex::start(large);
+  ex::start(small);
+  REQUIRE_FALSE(acquired);
+
+  // Cancelling the operation at the front lets the one behind it take the permit.
+  stop_source.request_stop();
+  REQUIRE(acquired);
+  semaphore.release(1);
+  REQUIRE(semaphore.try_acquire());
+}
+
+TEST_CASE("async_semaphore acquire of a stopped receiver does not take permits",
+          "[async_semaphore]") {
+  exec::async_semaphore semaphore{1};
+  ex::in_place_stop_source stop_source;
+  stop_source.request_stop();
+  auto op = ex::connect(
+    exec::write(semaphore.acquire(), exec::with(ex::get_stop_token, stop_source.get_token())),
+    expect_stopped_receiver{});
+  ex::start(op);
+  REQUIRE(semaphore.try_acquire());
+}
+
+TEST_CASE("async_mutex hands the lock to the next waiting operation", "[async_mutex]") {
+  exec::async_mutex mutex;
+  REQUIRE(mutex.try_lock());
+  bool locked = false;
+  auto op = ex::connect(mutex.lock() | ex::then([&] { locked = true; }), expect_void_receiver{});
+  ex::start(op);
+  REQUIRE_FALSE(locked);
+  mutex.unlock();
+  REQUIRE(locked);
+  REQUIRE_FALSE(mutex.try_lock());
+  mutex.unlock();
+  REQUIRE(mutex.try_lock());
+  mutex.unlock();
+}
+
+TEST_CASE("async_mutex lock with a scheduler resumes on that scheduler", "[async_mutex]") {
+  exec::static_thread_pool pool{1};
+  exec::async_mutex mutex;
+  REQUIRE(mutex.try_lock());
+  std::thread::id lock_thread;
+  exec::async_scope scope;
+  scope.spawn(
+    mutex.lock(pool.get_scheduler()) | ex::then([&] { lock_thread = std::this_thread::get_id(); }));
+  mutex.unlock();
+  ex::sync_wait(scope.on_empty());
+  REQUIRE(lock_thread != std::this_thread::get_id());
+  REQUIRE(lock_thread != std::thread::id{});
+  mutex.unlock();
+}
+
+TEST_CASE("async_mutex serializes critical sections across threads", "[async_mutex]") {
+  exec::static_thread_pool pool{4};
+  auto sch = pool.get_scheduler();
+  exec::async_mutex mutex;
+  exec::async_scope scope;
+  constexpr int tasks = 8;
+  constexpr int iterations = 1000;
+  // Deliberately not atomic: the mutex must order the increments.
+  long counter = 0;
+
+  auto increment = [&]() -> exec::task<void> {
+    for (int i = 0; i < iterations; ++i) {
+      co_await mutex.lock();
+      ++counter;
+      mutex.unlock();
+    }
+  };
+  for (int t = 0; t < tasks; ++t) {
+    scope.spawn(ex::on(sch, increment()));
+  }
+  ex::sync_wait(scope.on_empty());
+  REQUIRE(counter == tasks * iterations);
+}
+
+namespace {
+  // Records that an operation completed, whether it took the lock or was cancelled.
+  struct done_receiver {
+    using is_receiver = void;
+    std::atomic<bool>* done;
+
+    friend void tag_invoke(ex::set_value_t, done_receiver&& self) noexcept {
+      self.done->store(true, std::memory_order_release);
+    }
+
+    friend void tag_invoke(ex::set_stopped_t, done_receiver&& self) noexcept {
+      self.done->store(true, std::memory_order_release);
+    }
+
+    friend ex::empty_env tag_invoke(ex::get_env_t, const done_receiver&) noexcept {
+      return {};
+    }
+  };
+}
+
+TEST_CASE(
+  "async_mutex excludes try_lock, lock and cancelled lock from each other",
+  "[async_mutex]") {
+  exec::async_mutex mutex;
+  std::atomic<int> inside{0};
+  std::atomic<int> overlaps{0};
+  auto critical_section = [&]() noexcept {
+    if (inside.fetch_add(1) != 0) {
+      overlaps.fetch_add(1);
+    }
+    std::this_thread::yield();
+    inside.fetch_sub(1);
+    mutex.unlock();
+  };
+
+  constexpr int threads = 4;
+  constexpr int iterations = 3000;
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      for (int i = 0; i < iterations; ++i) {
+        switch ((i + t) % 3) {
+        case 0:
+          if (mutex.try_lock()) {
+            critical_section();
+          }
+          break;
+        case 1:
+          ex::sync_wait(mutex.lock() | ex::then(critical_section));
+          break;
+        case 2: {
+          // The stop request races with the unlock that would hand this operation the lock.
+          ex::in_place_stop_source stop_source;
+          std::atomic<bool> done{false};
+          auto op = ex::connect(
+            exec::write(
+              mutex.lock() | ex::then(critical_section),
+              exec::with(ex::get_stop_token, stop_source.get_token())),
+            done_receiver{&done});
+          ex::start(op);
+          stop_source.request_stop();
+          while (!done.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+          }
+          break;
+        }
+        }
+      }
+    });
+  }
+  for (std::thread& worker: workers) {
+    worker.join();
+  }
+  REQUIRE(overlaps.load() == 0);
+  REQUIRE(mutex.try_lock());
+  mutex.unlock();
+}
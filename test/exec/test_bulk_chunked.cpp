@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch2/catch.hpp>
+#include <exec/bulk_chunked.hpp>
+#include <exec/static_thread_pool.hpp>
+#include <test_common/receivers.hpp>
+#include <test_common/type_helpers.hpp>
+
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace ex = stdexec;
+
+TEST_CASE("bulk_chunked returns a sender", "[adaptors][bulk_chunked]") {
+  auto snd = exec::bulk_chunked(ex::just(19), 8, [](int, int, int) {});
+  static_assert(ex::sender<decltype(snd)>);
+  static_assert(ex::sender_in<decltype(snd), empty_env>);
+  (void) snd;
+}
+
+TEST_CASE("bulk_chunked calls the function once with the whole range", "[adaptors][bulk_chunked]") {
+  std::vector<std::pair<int, int>> calls;
+  auto snd = ex::just(42) //
+           | exec::bulk_chunked(10, [&](int begin, int end, int value) {
+               CHECK(value == 42);
+               calls.emplace_back(begin, end);
+             });
+  wait_for_value(std::move(snd), 42);
+  CHECK(calls == std::vector<std::pair<int, int>>{{0, 10}});
+}
+
+TEST_CASE(
+  "bulk_chunked with an empty shape does not call the function",
+  "[adaptors][bulk_chunked]") {
+  int calls = 0;
+  auto snd = ex::just() | exec::bulk_chunked(0, [&](int, int) { ++calls; });
+  auto op = ex::connect(std::move(snd), expect_void_receiver{});
+  ex::start(op);
+  CHECK(calls == 0);
+}
+
+TEST_CASE("bulk_chunked lets the function modify the values", "[adaptors][bulk_chunked]") {
+  std::vector<int> data(100, 1);
+  auto snd = ex::just(std::move(data)) //
+           | exec::bulk_chunked(100, [](int begin, int end, std::vector<int>& v) {
+               for (int i = begin; i < end; ++i) {
+                 v[i] += i;
+               }
+             });
+  auto [result] = ex::sync_wait(std::move(snd)).value();
+  for (int i = 0; i < 100; ++i) {
+    CHECK(result[i] == i + 1);
+  }
+}
+
+TEST_CASE("bulk_chunked forwards exceptions from the function", "[adaptors][bulk_chunked]") {
+  auto snd = ex::just() | exec::bulk_chunked(4, [](int, int) { throw std::logic_error{"bulk"}; });
+  auto op = ex::connect(std::move(snd), expect_error_receiver{});
+  ex::start(op);
+}
+
+TEST_CASE(
+  "bulk_chunked on static_thread_pool calls the function per thread",
+  "[adaptors][bulk_chunked]") {
+  exec::static_thread_pool pool{4};
+  std::mutex mutex;
+  std::vector<std::pair<int, int>> calls;
+  auto snd = ex::transfer_just(pool.get_scheduler(), 42)
+           | exec::bulk_chunked(1000, [&](int begin, int end, int value) {
+               CHECK(value == 42);
+               std::lock_guard lock{mutex};
+               calls.emplace_back(begin, end);
+             });
+  auto [value] = ex::sync_wait(std::move(snd)).value();
+  CHECK(value == 42);
+  // The ranges cover [0, 1000) exactly once, one per thread.
+  REQUIRE(calls.size() == 4);
+  std::sort(calls.begin(), calls.end());
+  int next = 0;
+  for (auto [begin, end]: calls) {
+    CHECK(begin == next);
+    next = end;
+  }
+  CHECK(next == 1000);
+}
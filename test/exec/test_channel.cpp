@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch2/catch.hpp>
+#include <exec/async_scope.hpp>
+#include <exec/channel.hpp>
+#include <exec/env.hpp>
+#include <exec/static_thread_pool.hpp>
+#include <exec/task.hpp>
+#include <test_common/receivers.hpp>
+#include <test_common/type_helpers.hpp>
+
+#include <atomic>
+#include <memory>
+#include <optional>
+
+namespace ex = stdexec;
+
+TEST_CASE("channel senders advertise their completions", "[channel]") {
+  exec::channel<int> ch{1};
+  check_val_types<type_array<type_array<>>>(ch.send(1));
+  check_val_types<type_array<type_array<int>>>(ch.receive());
+  check_sends_stopped<true>(ch.send(1));
+  check_sends_stopped<true>(ch.receive());
+}
+
+TEST_CASE("channel passes values through the buffer in order", "[channel]") {
+  exec::channel<int> ch{3};
+  for (int i = 0; i < 3; ++i) {
+    ex::sync_wait(ch.send(i));
+  }
+  for (int i = 0; i < 3; ++i) {
+    wait_for_value(ch.receive(), int{i});
+  }
+}
+
+TEST_CASE("channel receive waits for a send", "[channel]") {
+  exec::channel<int> ch{1};
+  std::optional<int> received;
+  auto op = ex::connect(
+    ch.receive() | ex::then([&](int value) { received = value; }), expect_void_receiver{});
+  ex::start(op);
+  REQUIRE_FALSE(received);
+  ex::sync_wait(ch.send(42));
+  REQUIRE(received == 42);
+}
+
+TEST_CASE("channel send waits while the channel is full", "[channel]") {
+  exec::channel<int> ch{1};
+  ex::sync_wait(ch.send(1));
+  bool sent = false;
+  auto op = ex::connect(ch.send(2) | ex::then([&] { sent = true; }), expect_void_receiver{});
+  ex::start(op);
+  REQUIRE_FALSE(sent);
+  wait_for_value(ch.receive(), 1);
+  REQUIRE(sent);
+  wait_for_value(ch.receive(), 2);
+}
+
+TEST_CASE("channel of capacity zero hands values over", "[channel]") {
+  exec::channel<std::unique_ptr<int>> ch{0};
+  bool sent = false;
+  auto op = ex::connect(
+    ch.send(std::make_unique<int>(7)) | ex::then([&] { sent = true; }), expect_void_receiver{});
+  ex::start(op);
+  REQUIRE_FALSE(sent);
+  auto [value] = ex::sync_wait(ch.receive()).value();
+  REQUIRE(sent);
+  REQUIRE(*value == 7);
+}
+
+TEST_CASE("channel operations can be cancelled while they wait", "[channel]") {
+  exec::channel<int> ch{1};
+  ex::in_place_stop_source stop_source;
+  auto receive_op = ex::connect(
+    exec::write(ch.receive(), exec::with(ex::get_stop_token, stop_source.get_token())),
+    expect_stopped_receiver{});
+  ex::start(receive_op);
+  stop_source.request_stop();
+
+  // The value is not handed to the cancelled receive operation.
+  ex::sync_wait(ch.send(1));
+  wait_for_value(ch.receive(), 1);
+}
+
+TEST_CASE("channel send of a stopped receiver does not send", "[channel]") {
+  exec::channel<int> ch{1};
+  ex::in_place_stop_source stop_source;
+  stop_source.request_stop();
+  auto op = ex::connect(
+    exec::write(ch.send(1), exec::with(ex::get_stop_token, stop_source.get_token())),
+    expect_stopped_receiver{});
+  ex::start(op);
+  ex::sync_wait(ch.send(2));
+  wait_for_value(ch.receive(), 2);
+}
+
+TEST_CASE("channel close stops waiting and later operations", "[channel]") {
+  exec::channel<int> ch{1};
+  ex::sync_wait(ch.send(1));
+  auto send_op = ex::connect(ch.send(2), expect_stopped_receiver{});
+  ex::start(send_op);
+  ch.close();
+
+  auto late_send_op = ex::connect(ch.send(3), expect_stopped_receiver{});
+  ex::start(late_send_op);
+  // The values in the channel can still be received.
+  wait_for_value(ch.receive(), 1);
+  auto receive_op = ex::connect(ch.receive(), expect_stopped_receiver{});
+  ex::start(receive_op);
+}
+
+TEST_CASE("channel connects producers and consumers across threads", "[channel]") {
+  exec::static_thread_pool pool{4};
+  auto sch = pool.get_scheduler();
+  exec::channel<int> ch{8};
+  exec::async_scope scope;
+  constexpr int producers = 4;
+  constexpr int consumers = 3;
+  constexpr int per_producer = 1000;
+  std::atomic<long> sum{0};
+  std::atomic<int> received{0};
+
+  auto produce = [](exec::channel<int>& ch, int first) -> exec::task<void> {
+    for (int i = 0; i < per_producer; ++i) {
+      co_await ch.send(first + i);
+    }
+  };
+  // Consumers run until the channel is closed after the last value.
+  auto consume = [&](exec::channel<int>& ch) -> exec::task<void> {
+    while (true) {
+      int value = co_await ch.receive();
+      sum += value;
+      if (++received == producers * per_producer) {
+        ch.close();
+      }
+    }
+  };
+  for (int p = 0; p < producers; ++p) {
+    scope.spawn(ex::on(sch, produce(ch, p * per_producer)));
+  }
+  for (int c = 0; c < consumers; ++c) {
+    scope.spawn(ex::on(sch, consume(ch)));
+  }
+  ex::sync_wait(scope.on_empty());
+
+  const long n = producers * per_producer;
+  REQUIRE(received.load() == n);
+  REQUIRE(sum.load() == n * (n - 1) / 2);
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch2/catch.hpp>
+#include <exec/queue_statistics.hpp>
+#include <exec/static_thread_pool.hpp>
+#include <test_common/receivers.hpp>
+
+#if __has_include(<linux/io_uring.h>)
+#include <exec/linux/io_uring_context.hpp>
+#endif
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+namespace ex = stdexec;
+namespace qs = stdexec::__queue_stats;
+
+using namespace std::chrono_literals;
+
+TEST_CASE("queue statistics buckets keep values within 1/32", "[queue_statistics]") {
+  for (std::uint64_t value = 0; value < 64; ++value) {
+    CHECK(qs::__bucket_upper_bound(qs::__bucket_index(value)) == value);
+  }
+  for (std::uint64_t value: {64ull, 100ull, 1000ull, 123456ull, 1ull << 40, ~0ull}) {
+    const std::size_t index = qs::__bucket_index(value);
+    REQUIRE(index < qs::__bucket_count);
+    const std::uint64_t upper = qs::__bucket_upper_bound(index);
+    CHECK(upper >= value);
+    CHECK(upper - value <= value / 32);
+    CHECK(qs::__bucket_index(upper) == index);
+    if (upper != ~0ull) {
+      CHECK(qs::__bucket_index(upper + 1) == index + 1);
+    }
+  }
+  CHECK(qs::__bucket_index(~0ull) == qs::__bucket_count - 1);
+}
+
+TEST_CASE("latency_histogram reports percentiles", "[queue_statistics]") {
+  qs::__histogram hist;
+  exec::latency_histogram empty{hist};
+  CHECK(empty.count() == 0);
+  CHECK(empty.percentile(99.0) == 0);
+  CHECK(empty.max() == 0);
+
+  for (std::uint64_t value = 1; value <= 1000; ++value) {
+    hist.__record(value * 1000);
+  }
+  exec::latency_histogram snapshot{hist};
+  CHECK(snapshot.count() == 1000);
+  CHECK(snapshot.percentile(0.0) >= 1000);
+  CHECK(snapshot.percentile(0.0) < 1000 * 33 / 32);
+  CHECK(snapshot.percentile(50.0) >= 500'000);
+  CHECK(snapshot.percentile(50.0) < 500'000 * 33 / 32);
+  CHECK(snapshot.percentile(99.0) >= 990'000);
+  CHECK(snapshot.percentile(99.0) < 990'000 * 33 / 32);
+  CHECK(snapshot.percentile(100.0) == snapshot.max());
+  CHECK(snapshot.max() >= 1'000'000);
+
+  exec::latency_histogram merged = snapshot;
+  merged += snapshot;
+  CHECK(merged.count() == 2000);
+  CHECK(merged.percentile(50.0) == snapshot.percentile(50.0));
+}
+
+TEST_CASE("static_thread_pool records nothing by default", "[queue_statistics]") {
+  exec::static_thread_pool pool{2};
+  ex::sync_wait(ex::schedule(pool.get_scheduler()));
+  exec::queue_statistics stats = exec::get_queue_statistics(pool);
+  CHECK(stats.queue_delay.count() == 0);
+  CHECK(stats.service_time.count() == 0);
+}
+
+TEST_CASE("static_thread_pool records queue delay and service time", "[queue_statistics]") {
+  exec::static_thread_pool pool{2};
+  pool.enable_queue_statistics();
+  auto sch = pool.get_scheduler();
+  for (int i = 0; i < 10; ++i) {
+    ex::sync_wait(ex::schedule(sch) | ex::then([] { std::this_thread::sleep_for(1ms); }));
+  }
+  ex::sync_wait(ex::schedule(sch) | ex::bulk(4, [](int) {}));
+
+  exec::queue_statistics stats = exec::get_queue_statistics(pool);
+  // Eleven schedule() tasks and a task per worker for the bulk.
+  CHECK(stats.queue_delay.count() == 13);
+  CHECK(stats.service_time.count() == 13);
+  CHECK(stats.service_time.max() >= 1'000'000);
+  CHECK(stats.service_time.percentile(50.0) >= 1'000'000);
+}
+
+TEST_CASE("run_loop records queue delay and service time", "[queue_statistics]") {
+  ex::run_loop loop;
+  CHECK(exec::get_queue_statistics(loop).queue_delay.count() == 0);
+  exec::enable_queue_statistics(loop);
+  auto sch = loop.get_scheduler();
+  auto op1 = ex::connect(ex::schedule(sch), expect_void_receiver{});
+  auto op2 = ex::connect(ex::schedule(sch), expect_void_receiver{});
+  ex::start(op1);
+  ex::start(op2);
+  std::this_thread::sleep_for(1ms);
+  loop.finish();
+  loop.run();
+
+  exec::queue_statistics stats = exec::get_queue_statistics(loop);
+  CHECK(stats.queue_delay.count() == 2);
+  CHECK(stats.service_time.count() == 2);
+  CHECK(stats.queue_delay.percentile(0.0) >= 1'000'000);
+}
+
+#if __has_include(<linux/io_uring.h>)
+TEST_CASE("io_uring_context records scheduled tasks", "[queue_statistics][io_uring]") {
+  exec::io_uring_context context;
+  context.enable_queue_statistics();
+  auto sch = context.get_scheduler();
+  std::thread io_thread{[&] {
+    context.run();
+  }};
+  for (int i = 0; i < 3; ++i) {
+    ex::sync_wait(ex::schedule(sch));
+  }
+  ex::sync_wait(exec::schedule_after(sch, 1ms));
+  context.request_stop();
+  io_thread.join();
+
+  // The timer waits for the kernel and is not recorded.
+  exec::queue_statistics stats = context.queue_statistics();
+  CHECK(stats.queue_delay.count() == 3);
+  CHECK(stats.service_time.count() == 3);
+}
+#endif
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch2/catch.hpp>
+#include <exec/reduce.hpp>
+#include <exec/static_thread_pool.hpp>
+#include <test_common/receivers.hpp>
+#include <test_common/type_helpers.hpp>
+
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ex = stdexec;
+
+namespace {
+  std::vector<int> iota_vector(int n) {
+    std::vector<int> result(n);
+    std::iota(result.begin(), result.end(), 0);
+    return result;
+  }
+}
+
+TEST_CASE("reduce returns a sender", "[adaptors][reduce]") {
+  auto snd = exec::reduce(ex::just(iota_vector(3)), 0);
+  static_assert(ex::sender<decltype(snd)>);
+  static_assert(ex::sender_in<decltype(snd), empty_env>);
+  (void) snd;
+}
+
+TEST_CASE("reduce sums the range by default", "[adaptors][reduce]") {
+  wait_for_value(exec::reduce(ex::just(iota_vector(100)), 0), 4950);
+}
+
+TEST_CASE("reduce of an empty range sends the initial value", "[adaptors][reduce]") {
+  wait_for_value(ex::just(std::vector<int>{}) | exec::reduce(42), 42);
+}
+
+TEST_CASE("transform_reduce transforms each element", "[adaptors][reduce]") {
+  auto snd = ex::just(iota_vector(10)) //
+           | exec::transform_reduce(0L, std::plus<>{}, [](int i) { return long{i} * i; });
+  wait_for_value(std::move(snd), 285L);
+}
+
+TEST_CASE("transform_reduce forwards exceptions", "[adaptors][reduce]") {
+  auto snd = ex::just(iota_vector(10)) //
+           | exec::transform_reduce(0, std::plus<>{}, [](int) -> int {
+               throw std::logic_error{"transform"};
+             });
+  auto op = ex::connect(std::move(snd), expect_error_receiver{});
+  ex::start(op);
+}
+
+TEST_CASE("reduce on static_thread_pool matches std::reduce", "[adaptors][reduce]") {
+  exec::static_thread_pool pool{4};
+  auto sch = pool.get_scheduler();
+  // Sizes below, at and above the number of threads.
+  for (int n: {0, 1, 3, 4, 5, 1000, 100'003}) {
+    std::vector<double> data(n);
+    for (int i = 0; i < n; ++i) {
+      data[i] = 1.0 / (1 << (i % 20));
+    }
+    auto [sum] = ex::sync_wait(ex::transfer_just(sch, data) | exec::reduce(0.5)).value();
+    CHECK(sum == std::reduce(data.begin(), data.end(), 0.5));
+  }
+}
+
+TEST_CASE("reduce on static_thread_pool combines in range order", "[adaptors][reduce]") {
+  exec::static_thread_pool pool{4};
+  auto sch = pool.get_scheduler();
+  std::vector<std::string> words;
+  std::string expected = ">";
+  for (int i = 0; i < 37; ++i) {
+    words.push_back(std::to_string(i));
+    expected += words.back();
+  }
+  // Concatenation is associative but not commutative.
+  auto [result] = ex::sync_wait(ex::transfer_just(sch, words) | exec::reduce(std::string{">"}))
+                    .value();
+  CHECK(result == expected);
+}
+
+TEST_CASE("transform_reduce on static_thread_pool forwards exceptions", "[adaptors][reduce]") {
+  exec::static_thread_pool pool{4};
+  auto sch = pool.get_scheduler();
+  auto snd = ex::transfer_just(sch, iota_vector(1000))
+           | exec::transform_reduce(0, std::plus<>{}, [](int i) {
+               if (i == 777) {
+                 throw std::logic_error{"transform"};
+               }
+               return i;
+             });
+  CHECK_THROWS_AS(ex::sync_wait(std::move(snd)), std::logic_error);
+}
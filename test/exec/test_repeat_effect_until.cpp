@@ -16,6 +16,7 @@
  */
 
 #include "exec/repeat_effect_until.hpp"
+#include "exec/env.hpp"
 #include "exec/on.hpp"
 #include "exec/trampoline_scheduler.hpp"
 #include "exec/static_thread_pool.hpp"
@@ -162,3 +163,43 @@ TEST_CASE("repeat_effect_until works when changing threads", "[adaptors][repeat_
 
   REQUIRE(called);
 }
+
+TEST_CASE(
+  "repeat_effect_until loops over a source that completes on another thread",
+  "[adaptors][repeat_effect_until]") {
+  exec::static_thread_pool pool{2};
+  int n = 0;
+  sender auto snd = exec::repeat_effect_until(
+    ex::schedule(pool.get_scheduler()) | ex::then([&n] { return ++n == 10'000; }));
+  stdexec::sync_wait(std::move(snd));
+  CHECK(n == 10'000);
+}
+
+TEST_CASE(
+  "repeat_effect_until checks for stop requests between iterations",
+  "[adaptors][repeat_effect_until]") {
+  ex::in_place_stop_source stop_source;
+  int n = 0;
+  sender auto snd = exec::repeat_effect_until(just() | then([&] {
+                                                if (++n == 5) {
+                                                  stop_source.request_stop();
+                                                }
+                                                return false;
+                                              }));
+  auto op = ex::connect(
+    exec::write(std::move(snd), exec::with(ex::get_stop_token, stop_source.get_token())),
+    expect_stopped_receiver{});
+  start(op);
+  CHECK(n == 5);
+}
+
+TEST_CASE(
+  "repeat_effect_until does not nest on the stack when its source loops too",
+  "[adaptors][repeat_effect_until]") {
+  int n = 0;
+  sender auto inner = exec::repeat_effect_until(just() | then([] { return true; }));
+  sender auto snd = exec::repeat_effect_until(
+    std::move(inner) | then([&n] { return ++n == 2'000'000; }));
+  stdexec::sync_wait(std::move(snd));
+  CHECK(n == 2'000'000);
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch2/catch.hpp>
+#include <exec/scan.hpp>
+#include <exec/static_thread_pool.hpp>
+#include <test_common/receivers.hpp>
+#include <test_common/type_helpers.hpp>
+
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ex = stdexec;
+
+namespace {
+  std::vector<int> iota_vector(int n) {
+    std::vector<int> result(n);
+    std::iota(result.begin(), result.end(), 0);
+    return result;
+  }
+}
+
+TEST_CASE("inclusive_scan returns a sender", "[adaptors][scan]") {
+  auto snd = exec::inclusive_scan(ex::just(iota_vector(3)));
+  static_assert(ex::sender<decltype(snd)>);
+  static_assert(ex::sender_in<decltype(snd), empty_env>);
+  (void) snd;
+}
+
+TEST_CASE("inclusive_scan sends the prefix sums", "[adaptors][scan]") {
+  wait_for_value(ex::just(iota_vector(5)) | exec::inclusive_scan(), std::vector{0, 1, 3, 6, 10});
+  wait_for_value(
+    ex::just(std::vector{1, 2, 3, 4}) | exec::inclusive_scan(std::multiplies<>{}),
+    std::vector{1, 2, 6, 24});
+}
+
+TEST_CASE("exclusive_scan starts from the initial value", "[adaptors][scan]") {
+  wait_for_value(
+    exec::exclusive_scan(ex::just(iota_vector(5)), 100), std::vector{100, 100, 101, 103, 106});
+  wait_for_value(ex::just(std::vector<int>{}) | exec::exclusive_scan(1), std::vector<int>{});
+}
+
+TEST_CASE("scan writes through a view of the caller's data", "[adaptors][scan]") {
+  std::vector<int> data = iota_vector(4);
+  ex::sync_wait(ex::just(std::span<int>{data}) | exec::inclusive_scan());
+  CHECK(data == std::vector{0, 1, 3, 6});
+}
+
+TEST_CASE("scans leave a range sent by reference unchanged", "[adaptors][scan]") {
+  exec::static_thread_pool pool{4};
+  std::vector<int> data = iota_vector(100);
+  auto by_reference = [&]() -> std::vector<int>& {
+    return data;
+  };
+  std::vector<int> expected(data.size());
+  std::inclusive_scan(data.begin(), data.end(), expected.begin());
+
+  // Sequentially, and on a scheduler that customizes the scans.
+  auto [sequential] =
+    ex::sync_wait(ex::just() | ex::then(by_reference) | exec::inclusive_scan()).value();
+  CHECK(sequential == expected);
+  CHECK(data == iota_vector(100));
+
+  auto [parallel] = ex::sync_wait(
+                      ex::schedule(pool.get_scheduler()) | ex::then(by_reference)
+                      | exec::inclusive_scan())
+                      .value();
+  CHECK(parallel == expected);
+  CHECK(data == iota_vector(100));
+
+  // Through a view, both write to the caller's data.
+  auto as_span = [&] {
+    return std::span<int>{data};
+  };
+  ex::sync_wait(ex::just() | ex::then(as_span) | exec::inclusive_scan());
+  CHECK(data == expected);
+  data = iota_vector(100);
+  ex::sync_wait(ex::schedule(pool.get_scheduler()) | ex::then(as_span) | exec::inclusive_scan());
+  CHECK(data == expected);
+}
+
+TEST_CASE("inclusive_scan forwards exceptions", "[adaptors][scan]") {
+  auto snd = ex::just(iota_vector(10)) | exec::inclusive_scan([](int, int) -> int {
+               throw std::logic_error{"scan"};
+             });
+  auto op = ex::connect(std::move(snd), expect_error_receiver{});
+  ex::start(op);
+}
+
+TEST_CASE("scans on static_thread_pool match the sequential scans", "[adaptors][scan]") {
+  exec::static_thread_pool pool{4};
+  auto sch = pool.get_scheduler();
+  // Sizes below, at and above the number of threads.
+  for (int n: {0, 1, 3, 4, 5, 1000, 100'003}) {
+    std::vector<long> data(n);
+    for (int i = 0; i < n; ++i) {
+      data[i] = (i * 7919) % 1000 - 500;
+    }
+
+    std::vector<long> inclusive(n);
+    std::inclusive_scan(data.begin(), data.end(), inclusive.begin());
+    auto [inclusive_result] =
+      ex::sync_wait(ex::transfer_just(sch, data) | exec::inclusive_scan()).value();
+    CHECK(inclusive_result == inclusive);
+
+    std::vector<long> exclusive(n);
+    std::exclusive_scan(data.begin(), data.end(), exclusive.begin(), 42L);
+    auto [exclusive_result] =
+      ex::sync_wait(ex::transfer_just(sch, data) | exec::exclusive_scan(42L)).value();
+    CHECK(exclusive_result == exclusive);
+  }
+}
+
+TEST_CASE("scans on static_thread_pool combine in range order", "[adaptors][scan]") {
+  exec::static_thread_pool pool{4};
+  auto sch = pool.get_scheduler();
+  std::vector<std::string> words;
+  for (int i = 0; i < 37; ++i) {
+    words.push_back(std::to_string(i));
+  }
+  // Concatenation is associative but not commutative.
+  std::vector<std::string> expected(words.size());
+  std::exclusive_scan(words.begin(), words.end(), expected.begin(), std::string{">"});
+  auto [result] =
+    ex::sync_wait(ex::transfer_just(sch, words) | exec::exclusive_scan(std::string{">"}))
+      .value();
+  CHECK(result == expected);
+}
+
+TEST_CASE("scans compose with the rest of a pipeline on static_thread_pool", "[adaptors][scan]") {
+  exec::static_thread_pool pool{4};
+  auto sch = pool.get_scheduler();
+  auto snd = ex::schedule(sch) | ex::then([] { return iota_vector(1000); })
+           | exec::inclusive_scan() | ex::then([](std::vector<int> sums) { return sums.back(); });
+  auto [last] = ex::sync_wait(std::move(snd)).value();
+  CHECK(last == 499500);
+}
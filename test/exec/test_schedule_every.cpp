@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if __has_include(<linux/io_uring.h>)
+#include <catch2/catch.hpp>
+#include <exec/env.hpp>
+#include <exec/linux/io_uring_context.hpp>
+#include <exec/sequence/ignore_all.hpp>
+#include <exec/sequence/schedule_every.hpp>
+#include <exec/sequence/transform_each.hpp>
+#include <test_common/type_helpers.hpp>
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace ex = stdexec;
+using namespace std::chrono_literals;
+
+namespace {
+  using time_point = std::chrono::steady_clock::time_point;
+
+  struct tick {
+    time_point deadline;
+    std::size_t missed;
+  };
+
+  struct io_thread {
+    exec::io_uring_context& context;
+    std::thread thread{[this] {
+      context.run();
+    }};
+
+    ~io_thread() {
+      context.request_stop();
+      thread.join();
+    }
+  };
+
+  // Waits for the ticks of sequence, and asks it to stop after count of them.
+  template <class Sequence, class Fn>
+  std::vector<tick> take(Sequence&& sequence, std::size_t count, Fn fn) {
+    ex::in_place_stop_source stop_source;
+    std::vector<tick> ticks;
+    auto all = (Sequence&&) sequence
+             | exec::transform_each(ex::then([&](time_point deadline, std::size_t missed) {
+                 ticks.push_back({deadline, missed});
+                 fn();
+                 if (ticks.size() == count) {
+                   stop_source.request_stop();
+                 }
+               }))
+             | exec::ignore_all();
+    auto result = ex::sync_wait(
+      exec::write(std::move(all), exec::with(ex::get_stop_token, stop_source.get_token())));
+    CHECK_FALSE(result.has_value());
+    return ticks;
+  }
+}
+
+TEST_CASE("schedule_every advertises its items and completions", "[sequence_senders]") {
+  using ticks_t = decltype(exec::schedule_every(std::declval<exec::io_uring_scheduler>(), 1ms));
+  STATIC_REQUIRE(exec::sequence_sender<ticks_t>);
+  using item_t = exec::__schedule_every::__tick_sender<time_point>;
+  STATIC_REQUIRE(std::same_as<exec::item_types_of_t<ticks_t>, exec::item_types<item_t>>);
+  check_val_types<type_array<type_array<time_point, std::size_t>>>(item_t{});
+  STATIC_REQUIRE(std::same_as<
+                 ex::error_types_of_t<ticks_t, ex::empty_env, type_array>,
+                 type_array<std::exception_ptr>>);
+  STATIC_REQUIRE(ex::sends_stopped<ticks_t, ex::empty_env>);
+}
+
+TEST_CASE("schedule_every rejects a period that is not positive", "[sequence_senders]") {
+  exec::io_uring_context context;
+  io_thread thread{context};
+  auto sch = context.get_scheduler();
+  CHECK_THROWS_AS(exec::schedule_every(sch, 0ms), std::invalid_argument);
+  CHECK_THROWS_AS(exec::schedule_every(sch, -1ms), std::invalid_argument);
+}
+
+TEST_CASE("schedule_every ticks on deadlines that do not drift", "[sequence_senders]") {
+  exec::io_uring_context context;
+  io_thread thread{context};
+  auto sch = context.get_scheduler();
+  time_point before = exec::now(sch);
+  std::vector<tick> ticks = take(exec::schedule_every(sch, 2ms), 5, [&] {
+    // Each tick comes at its deadline or later.
+    CHECK(exec::now(sch) >= ticks.back().deadline);
+  });
+  REQUIRE(ticks.size() == 5);
+  CHECK(ticks[0].deadline >= before + 2ms);
+  for (std::size_t i = 1; i < ticks.size(); ++i) {
+    std::size_t periods = 1 + ticks[i].missed;
+    CHECK(ticks[i].deadline - ticks[i - 1].deadline == periods * 2ms);
+  }
+}
+
+TEST_CASE("schedule_every skips the ticks missed by a slow receiver", "[sequence_senders]") {
+  exec::io_uring_context context;
+  io_thread thread{context};
+  auto sch = context.get_scheduler();
+  std::vector<tick> ticks = take(exec::schedule_every(sch, 2ms), 3, [] {
+    std::this_thread::sleep_for(5ms);
+  });
+  REQUIRE(ticks.size() == 3);
+  CHECK(ticks[0].missed == 0);
+  for (std::size_t i = 1; i < ticks.size(); ++i) {
+    // The receiver takes more than two periods, so at least two ticks are missed each time,
+    // and the next tick comes at the first deadline after that.
+    CHECK(ticks[i].missed >= 2);
+    CHECK(ticks[i].deadline - ticks[i - 1].deadline == (1 + ticks[i].missed) * 2ms);
+  }
+}
+
+TEST_CASE("schedule_every stops when the receiver wants no more items", "[sequence_senders]") {
+  exec::io_uring_context context;
+  io_thread thread{context};
+  int seen = 0;
+  auto all = exec::schedule_every(context.get_scheduler(), 1ms)
+           | exec::transform_each(ex::let_value([&](time_point, std::size_t) {
+               ++seen;
+               return ex::just_stopped();
+             }))
+           | exec::ignore_all();
+  CHECK_FALSE(ex::sync_wait(std::move(all)).has_value());
+  CHECK(seen == 1);
+}
+#endif
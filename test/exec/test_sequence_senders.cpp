@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch2/catch.hpp>
+#include <exec/async_semaphore.hpp>
+#include <exec/env.hpp>
+#include <exec/sequence/buffer.hpp>
+#include <exec/sequence/ignore_all.hpp>
+#include <exec/sequence/iterate.hpp>
+#include <exec/sequence/merge.hpp>
+#include <exec/sequence/transform_each.hpp>
+#include <exec/static_thread_pool.hpp>
+#include <test_common/receivers.hpp>
+#include <test_common/type_helpers.hpp>
+
+#include <atomic>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <vector>
+
+namespace ex = stdexec;
+
+namespace {
+  template <class Items>
+  struct only_item;
+
+  template <class Item>
+  struct only_item<exec::item_types<Item>> {
+    using type = Item;
+  };
+
+  // An item adaptor whose items wait for a permit of the semaphore before they complete.
+  auto gated(exec::async_semaphore& gate, int& started) {
+    return ex::let_value([&](int) {
+      ++started;
+      return gate.acquire();
+    });
+  }
+}
+
+TEST_CASE("sequence adaptors advertise their items and completions", "[sequence_senders]") {
+  std::vector<int> values{1, 2, 3};
+  auto sequence = exec::iterate(values);
+  STATIC_REQUIRE(exec::sequence_sender<decltype(sequence)>);
+  using item_t = exec::__iterate::__item_sender<std::vector<int>::iterator>;
+  STATIC_REQUIRE(std::same_as<exec::item_types_of_t<decltype(sequence)>, exec::item_types<item_t>>);
+  check_val_types<type_array<type_array<int&>>>(item_t{values.begin()});
+
+  auto doubled = sequence | exec::transform_each(ex::then([](int i) { return 2.0 * i; }));
+  STATIC_REQUIRE(exec::sequence_sender<decltype(doubled)>);
+  using doubled_item_t = only_item<exec::item_types_of_t<decltype(doubled)>>::type;
+  check_val_types<type_array<type_array<double>>>(doubled_item_t{});
+
+  auto all = std::move(doubled) | exec::ignore_all();
+  check_val_types<type_array<type_array<>>>(all);
+  check_err_types<type_array<std::exception_ptr>>(all);
+  check_sends_stopped<true>(all);
+}
+
+TEST_CASE("iterate produces the elements of a range in order", "[sequence_senders]") {
+  std::vector<int> values{1, 2, 3, 4};
+  std::vector<int> seen;
+  ex::sync_wait(
+    exec::iterate(values) | exec::transform_each(ex::then([&](int i) { seen.push_back(i); }))
+    | exec::ignore_all());
+  REQUIRE(seen == values);
+
+  // An rvalue range is moved into the sequence.
+  int sum = 0;
+  ex::sync_wait(
+    exec::iterate(std::vector{5, 6}) | exec::transform_each(ex::then([&](int i) { sum += i; }))
+    | exec::ignore_all());
+  REQUIRE(sum == 11);
+}
+
+TEST_CASE("iterate produces the next item once the previous one is done", "[sequence_senders]") {
+  std::vector<int> values{1, 2, 3};
+  exec::async_semaphore gate{0};
+  int started = 0;
+  auto op = ex::connect(
+    exec::iterate(values) | exec::transform_each(gated(gate, started)) | exec::ignore_all(),
+    expect_void_receiver{});
+  ex::start(op);
+  REQUIRE(started == 1);
+  gate.release();
+  REQUIRE(started == 2);
+  gate.release(2);
+  REQUIRE(started == 3);
+}
+
+TEST_CASE("ignore_all completes with the error of an item", "[sequence_senders]") {
+  std::vector<int> values{1, 2, 3, 4};
+  int seen = 0;
+  auto failing = ex::let_value([&](int i) {
+    ++seen;
+    return ex::just() | ex::then([i] {
+             if (i == 2) {
+               throw i;
+             }
+           });
+  });
+  REQUIRE_THROWS_AS(
+    ex::sync_wait(exec::iterate(values) | exec::transform_each(failing) | exec::ignore_all()),
+    int);
+  // The sequence was asked to stop after the failing item.
+  REQUIRE(seen == 2);
+}
+
+TEST_CASE("iterate stops producing items once stop is requested", "[sequence_senders]") {
+  std::vector<int> values{1, 2, 3};
+  ex::in_place_stop_source stop_source;
+  int seen = 0;
+  auto sender = exec::iterate(values) | exec::transform_each(ex::then([&](int) {
+                  if (++seen == 2) {
+                    stop_source.request_stop();
+                  }
+                }))
+              | exec::ignore_all();
+  auto op = ex::connect(
+    exec::write(std::move(sender), exec::with(ex::get_stop_token, stop_source.get_token())),
+    expect_stopped_receiver{});
+  ex::start(op);
+  REQUIRE(seen == 2);
+}
+
+TEST_CASE("iterate does not nest on the stack within another iterate", "[sequence_senders]") {
+  // Each item of the outer sequence runs an inner sequence to completion, so the loops of
+  // the two are interleaved on the stack.
+  std::vector<int> inner{1};
+  long seen = 0;
+  auto nested = exec::iterate(std::views::iota(0, 2'000'000))
+              | exec::transform_each(ex::let_value([&](int) {
+                  return exec::iterate(inner)
+                       | exec::transform_each(ex::then([&](int i) { seen += i; }))
+                       | exec::ignore_all();
+                }))
+              | exec::ignore_all();
+  ex::sync_wait(std::move(nested));
+  REQUIRE(seen == 2'000'000);
+}
+
+TEST_CASE("merge produces the items of all sequences", "[sequence_senders]") {
+  std::vector<int> first{1, 2, 3};
+  std::vector<int> second{10, 20};
+  int sum = 0;
+  auto merged = exec::merge(exec::iterate(first), exec::iterate(second));
+  // Both sequences have the same item type.
+  only_item<exec::item_types_of_t<decltype(merged)>>::type item{first.begin()};
+  check_val_types<type_array<type_array<int&>>>(item);
+  ex::sync_wait(
+    std::move(merged) | exec::transform_each(ex::then([&](int i) { sum += i; }))
+    | exec::ignore_all());
+  REQUIRE(sum == 36);
+}
+
+TEST_CASE("merge stops the other sequences when one fails", "[sequence_senders]") {
+  std::vector<int> values{1, 2, 3};
+  exec::async_semaphore gate{0};
+  int started = 0;
+  auto waiting = exec::iterate(values) | exec::transform_each(gated(gate, started));
+  auto failing = exec::iterate(values) | exec::transform_each(ex::let_value([](int i) {
+                   return ex::just_error(i);
+                 }));
+  auto op = ex::connect(
+    exec::merge(std::move(waiting), std::move(failing)) | exec::ignore_all(),
+    expect_error_receiver{1});
+  ex::start(op);
+  REQUIRE(started == 1);
+  // The first sequence produces no more items once its current one is done.
+  gate.release();
+  REQUIRE(started == 1);
+}
+
+TEST_CASE("buffer lets the producer run ahead of the receiver", "[sequence_senders]") {
+  std::vector<int> values{1, 2, 3, 4};
+  exec::async_semaphore gate{0};
+  int started = 0;
+  auto op = ex::connect(
+    exec::iterate(values) | exec::transform_each(gated(gate, started)) | exec::buffer(2)
+      | exec::ignore_all(),
+    expect_void_receiver{});
+  ex::start(op);
+  REQUIRE(started == 2);
+  gate.release();
+  REQUIRE(started == 3);
+  gate.release(3);
+  REQUIRE(started == 4);
+}
+
+TEST_CASE("buffer stops the producer when the receiver wants no more items",
+          "[sequence_senders]") {
+  std::vector<int> values{1, 2, 3, 4, 5};
+  exec::async_semaphore gate{0};
+  int started = 0;
+  auto op = ex::connect(
+    exec::iterate(values) | exec::transform_each(gated(gate, started))
+      | exec::transform_each(ex::let_value([] { return ex::just_error(-1); })) | exec::buffer(2)
+      | exec::ignore_all(),
+    expect_error_receiver{-1});
+  ex::start(op);
+  REQUIRE(started == 2);
+  // The item waiting for a slot is not started once the first item failed.
+  gate.release(2);
+  REQUIRE(started == 2);
+}
+
+TEST_CASE("buffer rejects a size of zero", "[sequence_senders]") {
+  std::vector<int> values{1, 2, 3};
+  CHECK_THROWS_AS(exec::buffer(exec::iterate(values), 0), std::invalid_argument);
+  CHECK_THROWS_AS(exec::buffer(0), std::invalid_argument);
+}
+
+TEST_CASE("sequence pipelines run items on a thread pool", "[sequence_senders]") {
+  exec::static_thread_pool pool{4};
+  auto sch = pool.get_scheduler();
+  std::vector<int> first(500);
+  std::vector<int> second(500);
+  std::iota(first.begin(), first.end(), 0);
+  std::iota(second.begin(), second.end(), 500);
+  std::atomic<long> sum{0};
+  auto on_pool = ex::let_value([&](int i) {
+    return ex::schedule(sch) | ex::then([&, i] { sum += i; });
+  });
+  ex::sync_wait(
+    exec::merge(
+      exec::iterate(first) | exec::transform_each(on_pool) | exec::buffer(8),
+      exec::iterate(second) | exec::transform_each(on_pool) | exec::buffer(8))
+    | exec::ignore_all());
+  REQUIRE(sum.load() == 1000L * 999 / 2);
+}
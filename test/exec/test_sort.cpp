@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch2/catch.hpp>
+#include <exec/inline_scheduler.hpp>
+#include <exec/sort.hpp>
+#include <exec/static_thread_pool.hpp>
+#include <test_common/receivers.hpp>
+#include <test_common/type_helpers.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ex = stdexec;
+
+namespace {
+  std::vector<int> shuffled(int n, int distinct) {
+    std::vector<int> result(n);
+    for (int i = 0; i < n; ++i) {
+      result[i] = static_cast<int>((i * 7919L + 13) % distinct);
+    }
+    return result;
+  }
+
+  template <class T>
+  struct counting_allocator : std::allocator<T> {
+    int* allocations = nullptr;
+
+    counting_allocator() = default;
+
+    explicit counting_allocator(int* count) noexcept
+      : allocations(count) {
+    }
+
+    template <class U>
+    counting_allocator(const counting_allocator<U>& other) noexcept
+      : allocations(other.allocations) {
+    }
+
+    template <class U>
+    struct rebind {
+      using other = counting_allocator<U>;
+    };
+
+    T* allocate(std::size_t n) {
+      ++*allocations;
+      return std::allocator<T>::allocate(n);
+    }
+  };
+}
+
+TEST_CASE("sort returns a sender", "[adaptors][sort]") {
+  auto snd = exec::sort(exec::inline_scheduler{}, std::vector{3, 1, 2});
+  static_assert(ex::sender<decltype(snd)>);
+  static_assert(ex::sender_in<decltype(snd), empty_env>);
+  (void) snd;
+}
+
+TEST_CASE("sort on inline_scheduler sorts sequentially", "[adaptors][sort]") {
+  wait_for_value(exec::sort(exec::inline_scheduler{}, std::vector{3, 1, 2}), std::vector{1, 2, 3});
+  wait_for_value(
+    exec::sort(exec::inline_scheduler{}, std::vector{3, 1, 2}, std::greater<>{}),
+    std::vector{3, 2, 1});
+}
+
+TEST_CASE("sort sorts the caller's elements through a view", "[adaptors][sort]") {
+  std::vector<int> data = shuffled(100, 100);
+  ex::sync_wait(exec::sort(exec::inline_scheduler{}, std::span{data}));
+  CHECK(std::is_sorted(data.begin(), data.end()));
+}
+
+TEST_CASE("sort forwards exceptions from the comparison", "[adaptors][sort]") {
+  auto snd = exec::sort(exec::inline_scheduler{}, std::vector{3, 1, 2}, [](int, int) -> bool {
+    throw std::logic_error{"compare"};
+  });
+  auto op = ex::connect(std::move(snd), expect_error_receiver{});
+  ex::start(op);
+}
+
+TEST_CASE("sort on static_thread_pool matches std::sort", "[adaptors][sort]") {
+  exec::static_thread_pool pool{4};
+  auto sch = pool.get_scheduler();
+  // Sizes sorted by one part and by all of them, with few and with many distinct keys.
+  for (int n: {0, 1, 1000, 20'000, 100'003}) {
+    for (int distinct: {1, 3, 1'000'000}) {
+      std::vector<int> data = shuffled(n, distinct);
+      std::vector<int> expected = data;
+      std::sort(expected.begin(), expected.end());
+      auto [result] = ex::sync_wait(exec::sort(sch, data)).value();
+      CHECK(result == expected);
+    }
+  }
+}
+
+TEST_CASE("sort on static_thread_pool uses the comparison and the allocator", "[adaptors][sort]") {
+  exec::static_thread_pool pool{4};
+  std::vector<std::string> data;
+  for (int i = 0; i < 50'000; ++i) {
+    data.push_back(std::to_string((i * 7919L) % 50'000));
+  }
+  std::vector<std::string> expected = data;
+  std::sort(expected.begin(), expected.end(), std::greater<>{});
+
+  int allocations = 0;
+  counting_allocator<std::string> alloc{&allocations};
+  ex::sync_wait(exec::sort(pool.get_scheduler(), std::span{data}, std::greater<>{}, alloc));
+  CHECK(data == expected);
+  CHECK(allocations == 1);
+}
+
+TEST_CASE("sort on static_thread_pool forwards exceptions", "[adaptors][sort]") {
+  exec::static_thread_pool pool{4};
+  std::vector<int> data = shuffled(100'000, 1000);
+  auto snd = exec::sort(pool.get_scheduler(), std::span{data}, [](int a, int b) {
+    if (a == 999 || b == 999) {
+      throw std::logic_error{"compare"};
+    }
+    return a < b;
+  });
+  CHECK_THROWS_AS(ex::sync_wait(std::move(snd)), std::logic_error);
+}
@@ -23,6 +23,10 @@
 
 #include <catch2/catch.hpp>
 
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
 #include <thread>
 
 using namespace exec;
@@ -220,5 +224,214 @@ TEST_CASE("Stick on main thread if completes_inline is not used", "[types][stick
   sync_wait(std::move(t));
 }
 
+namespace {
+  task<int> sum_to(int n) {
+    if (n == 0) {
+      co_return 0;
+    }
+    co_return n + co_await sum_to(n - 1);
+  }
+
+  struct allocation_counts {
+    int allocations{0};
+    int deallocations{0};
+  };
+
+  template <class T>
+  struct counting_allocator {
+    using value_type = T;
+    allocation_counts* counts_;
+
+    explicit counting_allocator(allocation_counts* counts) noexcept
+      : counts_{counts} {
+    }
+
+    template <class U>
+    counting_allocator(const counting_allocator<U>& other) noexcept
+      : counts_{other.counts_} {
+    }
+
+    T* allocate(std::size_t n) {
+      ++counts_->allocations;
+      return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+      ++counts_->deallocations;
+      std::allocator<T>{}.deallocate(p, n);
+    }
+
+    friend bool operator==(const counting_allocator&, const counting_allocator&) = default;
+  };
+
+  task<int> allocated_sum_to(std::allocator_arg_t, counting_allocator<std::byte> alloc, int n) {
+    if (n == 0) {
+      co_return 0;
+    }
+    co_return n + co_await allocated_sum_to(std::allocator_arg, alloc, n - 1);
+  }
+
+  struct allocating_object {
+    int value_;
+
+    task<int> get(std::allocator_arg_t, counting_allocator<std::byte>) {
+      co_return value_;
+    }
+  };
+}
+
+TEST_CASE("Deeply nested tasks recycle their frames", "[types][task]") {
+  for (int i = 0; i < 3; ++i) {
+    auto [result] = sync_wait(sum_to(1000)).value();
+    CHECK(result == 500500);
+  }
+}
+
+TEST_CASE("Task frames can be released after the thread's frame cache", "[types][task]") {
+  struct holder {
+    std::optional<task<int>> task_;
+  };
+
+  std::thread thread{[] {
+    // Thread-local objects are destroyed in the reverse order of their construction, so
+    // this holder, constructed before the frame cache, releases its frame after the cache
+    // is gone.
+    thread_local holder late{};
+    late.task_.emplace(sum_to(1));
+    auto [result] = sync_wait(sum_to(10)).value();
+    CHECK(result == 55);
+  }};
+  thread.join();
+}
+
+TEST_CASE("Task frames are allocated with a leading allocator argument", "[types][task]") {
+  allocation_counts counts{};
+  {
+    auto t = allocated_sum_to(std::allocator_arg, counting_allocator<std::byte>{&counts}, 10);
+    CHECK(counts.allocations == 1);
+    auto [result] = sync_wait(std::move(t)).value();
+    CHECK(result == 55);
+  }
+  CHECK(counts.allocations == 11);
+  CHECK(counts.deallocations == 11);
+}
+
+TEST_CASE("Member task frames are allocated with a leading allocator argument", "[types][task]") {
+  allocation_counts counts{};
+  allocating_object object{42};
+  {
+    auto t = object.get(std::allocator_arg, counting_allocator<std::byte>{&counts});
+    auto [result] = sync_wait(std::move(t)).value();
+    CHECK(result == 42);
+  }
+  CHECK(counts.allocations == 1);
+  CHECK(counts.deallocations == 1);
+}
+
+namespace {
+  // Forwards to another scheduler, counting the calls to schedule.
+  template <class Scheduler>
+  struct counting_scheduler {
+    Scheduler sched_;
+    std::atomic<int>* schedules_;
+
+    struct env {
+      counting_scheduler sched_;
+
+      template <class CPO>
+      friend counting_scheduler
+        tag_invoke(get_completion_scheduler_t<CPO>, const env& self) noexcept {
+        return self.sched_;
+      }
+    };
+
+    struct sender {
+      using is_sender = void;
+      using completion_signatures =
+        completion_signatures_of_t<schedule_result_t<Scheduler&>, empty_env>;
+      schedule_result_t<Scheduler&> sndr_;
+      counting_scheduler sched_;
+
+      template <receiver R>
+      friend auto tag_invoke(connect_t, sender self, R rcvr) {
+        return connect(std::move(self.sndr_), (R&&) rcvr);
+      }
+
+      friend env tag_invoke(get_env_t, const sender& self) noexcept {
+        return {self.sched_};
+      }
+    };
+
+    friend sender tag_invoke(schedule_t, counting_scheduler self) {
+      ++*self.schedules_;
+      return {schedule(self.sched_), self};
+    }
+
+    bool operator==(const counting_scheduler&) const noexcept = default;
+  };
+
+  template <class Scheduler>
+  task<void> schedule_n_times(Scheduler sched, int n) {
+    for (int i = 0; i < n; ++i) {
+      co_await schedule(sched);
+    }
+  }
+
+  task<int> count_inline_completions(int n) {
+    int count = 0;
+    for (int i = 0; i < n; ++i) {
+      count += co_await just(1);
+    }
+    co_return count;
+  }
+}
+
+TEST_CASE(
+  "Awaiting a sender that completes on the task's scheduler does not reschedule",
+  "[types][sticky][task]") {
+  single_thread_context context;
+  std::atomic<int> schedules{0};
+  counting_scheduler<decltype(context.get_scheduler())> sched{context.get_scheduler(), &schedules};
+  sync_wait(on(sched, schedule_n_times(sched, 10)));
+  // One for on and one for each co_await, but none to transition back onto the scheduler.
+  CHECK(schedules.load() == 11);
+}
+
+TEST_CASE("Awaiting a sender that completes inline does not reschedule", "[types][sticky][task]") {
+  single_thread_context context;
+  std::atomic<int> schedules{0};
+  counting_scheduler<decltype(context.get_scheduler())> sched{context.get_scheduler(), &schedules};
+  auto [count] = sync_wait(on(sched, count_inline_completions(10))).value();
+  CHECK(count == 10);
+  CHECK(schedules.load() == 1);
+}
+
+TEST_CASE("Many inline completions do not exhaust the stack", "[types][sticky][task]") {
+  single_thread_context context;
+  auto [count] =
+    sync_wait(on(context.get_scheduler(), count_inline_completions(100'000))).value();
+  CHECK(count == 100'000);
+}
+
+namespace {
+  template <class Scheduler>
+  task<void> schedule_once(Scheduler sched) {
+    co_await schedule(sched);
+  }
+
+  template <class Scheduler>
+  task<void> await_child_task(Scheduler sched) {
+    co_await schedule_once(sched);
+  }
+}
+
+TEST_CASE("Awaiting a task does not reschedule", "[types][sticky][task]") {
+  single_thread_context context;
+  std::atomic<int> schedules{0};
+  counting_scheduler<decltype(context.get_scheduler())> sched{context.get_scheduler(), &schedules};
+  sync_wait(on(sched, await_child_task(sched)));
+  // One for on and one for the child's co_await.
+  CHECK(schedules.load() == 2);
+}
 
 #endif
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// No other test includes exec/trace.hpp, so tracing can be enabled for this file alone.
+#define STDEXEC_ENABLE_TRACING 1
+
+#include <catch2/catch.hpp>
+#include <exec/trace.hpp>
+#include <exec/static_thread_pool.hpp>
+#include <test_common/receivers.hpp>
+#include <test_common/schedulers.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace ex = stdexec;
+
+namespace {
+  std::vector<exec::trace_event> events_named(const char* name) {
+    std::vector<exec::trace_event> events = exec::collect_trace();
+    std::erase_if(events, [&](const exec::trace_event& event) {
+      return std::strcmp(event.name, name) != 0;
+    });
+    return events;
+  }
+}
+
+TEST_CASE("trace forwards the completions of its sender", "[adaptors][trace]") {
+  wait_for_value(ex::just(42) | exec::trace("forwards"), 42);
+  auto op = ex::connect(
+    ex::just_error(42) | exec::trace("forwards"), expect_error_receiver<int>{42});
+  ex::start(op);
+}
+
+TEST_CASE("trace records the start and the completion", "[adaptors][trace]") {
+  wait_for_value(ex::just(1) | exec::trace("value"), 1);
+  auto events = events_named("value");
+  REQUIRE(events.size() == 2);
+  CHECK(events[0].kind == exec::trace_event_kind::start);
+  CHECK(events[1].kind == exec::trace_event_kind::set_value);
+  CHECK(events[0].operation == events[1].operation);
+  CHECK(events[0].timestamp_ns <= events[1].timestamp_ns);
+}
+
+TEST_CASE("trace records errors and stopped", "[adaptors][trace]") {
+  {
+    auto op = ex::connect(ex::just_error(42) | exec::trace("error"), expect_error_receiver<int>{});
+    ex::start(op);
+  }
+  {
+    auto op = ex::connect(ex::just_stopped() | exec::trace("stopped"), expect_stopped_receiver{});
+    ex::start(op);
+  }
+  auto errors = events_named("error");
+  REQUIRE(errors.size() == 2);
+  CHECK(errors[1].kind == exec::trace_event_kind::set_error);
+  auto stopped = events_named("stopped");
+  REQUIRE(stopped.size() == 2);
+  CHECK(stopped[1].kind == exec::trace_event_kind::set_stopped);
+}
+
+TEST_CASE("trace records completions on the completing thread", "[adaptors][trace]") {
+  exec::static_thread_pool pool{2};
+  ex::sync_wait(ex::schedule(pool.get_scheduler()) | exec::trace("on pool"));
+  auto events = events_named("on pool");
+  REQUIRE(events.size() == 2);
+  auto start = std::find_if(events.begin(), events.end(), [](const auto& event) {
+    return event.kind == exec::trace_event_kind::start;
+  });
+  auto value = std::find_if(events.begin(), events.end(), [](const auto& event) {
+    return event.kind == exec::trace_event_kind::set_value;
+  });
+  REQUIRE(start != events.end());
+  REQUIRE(value != events.end());
+  CHECK(start->thread != value->thread);
+  CHECK(start->operation == value->operation);
+}
+
+TEST_CASE("trace keeps the completion scheduler of its sender", "[adaptors][trace]") {
+  exec::static_thread_pool pool{2};
+  auto sch = pool.get_scheduler();
+  auto snd = ex::schedule(sch) | exec::trace("scheduler");
+  CHECK(ex::get_completion_scheduler<ex::set_value_t>(ex::get_env(snd)) == sch);
+}
+
+TEST_CASE("write_chrome_trace writes async begin and end events", "[adaptors][trace]") {
+  wait_for_value(ex::just() | exec::trace("chrome \"trace\""));
+  std::ostringstream out;
+  exec::write_chrome_trace(out);
+  std::string json = out.str();
+  CHECK(json.find("{\"traceEvents\":[") == 0);
+  CHECK(json.find("\"name\":\"chrome \\\"trace\\\"\",\"cat\":\"stdexec\",\"ph\":\"b\"")
+        != std::string::npos);
+  CHECK(json.find("\"ph\":\"e\"") != std::string::npos);
+  CHECK(json.find("\"completion\":\"set_value\"") != std::string::npos);
+}
+
+TEST_CASE("trace frees the buffers of exited threads once collected", "[adaptors][trace]") {
+  constexpr std::size_t max_retired = exec::__trace::__registry::__max_retired;
+  for (std::size_t i = 0; i < 2 * max_retired; ++i) {
+    std::thread{[] {
+      ex::sync_wait(ex::just() | exec::trace("exited"));
+    }}.join();
+  }
+  // Only the buffers of the last threads are kept, and their events are returned once.
+  CHECK(events_named("exited").size() == 2 * max_retired);
+  CHECK(events_named("exited").empty());
+}
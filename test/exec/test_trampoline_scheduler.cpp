@@ -19,11 +19,13 @@
 
 #include "../../include/exec/on.hpp"
 #include "../test_common/require_terminate.hpp"
+#include "../test_common/receivers.hpp"
 #include "../test_common/retry.hpp"
 
 #include <catch2/catch.hpp>
 #include <exception>
 #include <memory>
+#include <vector>
 
 using namespace stdexec;
 
@@ -79,3 +81,65 @@ TEST_CASE(
   auto recurse_deeply = retry(exec::on(sched, fails_alot{}));
   sync_wait(std::move(recurse_deeply));
 }
+
+namespace {
+  struct order_receiver {
+    using is_receiver = void;
+    std::vector<int>* order_;
+    int id_;
+
+    friend void tag_invoke(set_value_t, order_receiver&& self) noexcept {
+      self.order_->push_back(self.id_);
+    }
+
+    friend void tag_invoke(set_stopped_t, order_receiver&&) noexcept {
+    }
+
+    friend empty_env tag_invoke(get_env_t, const order_receiver&) noexcept {
+      return {};
+    }
+  };
+
+  // Starts three nested schedule operations from within a fourth.
+  std::vector<int> run_nested(exec::trampoline_scheduler sched) {
+    std::vector<int> order;
+    auto op1 = connect(schedule(sched), order_receiver{&order, 1});
+    auto op2 = connect(schedule(sched), order_receiver{&order, 2});
+    auto op3 = connect(schedule(sched), order_receiver{&order, 3});
+    auto outer = connect(
+      schedule(sched) | then([&] {
+        start(op1);
+        start(op2);
+        start(op3);
+        order.push_back(0);
+      }),
+      expect_void_receiver{});
+    start(outer);
+    return order;
+  }
+}
+
+TEST_CASE(
+  "trampoline_scheduler runs deferred operations in FIFO order",
+  "[schedulers][trampoline_scheduler]") {
+  exec::trampoline_scheduler::reset_statistics();
+  CHECK(run_nested(exec::trampoline_scheduler{1}) == std::vector{0, 1, 2, 3});
+  auto stats = exec::trampoline_scheduler::statistics();
+  CHECK(stats.inline_starts == 1);
+  CHECK(stats.deferred_starts == 3);
+}
+
+TEST_CASE(
+  "trampoline_scheduler defers operations once the stack budget is used up",
+  "[schedulers][trampoline_scheduler]") {
+  constexpr std::size_t unlimited_depth = ~std::size_t{0};
+
+  exec::trampoline_scheduler::reset_statistics();
+  CHECK(run_nested(exec::trampoline_scheduler{unlimited_depth, 1}) == std::vector{0, 1, 2, 3});
+  CHECK(exec::trampoline_scheduler::statistics().deferred_starts == 3);
+
+  exec::trampoline_scheduler::reset_statistics();
+  CHECK(
+    run_nested(exec::trampoline_scheduler{unlimited_depth, 1 << 20}) == std::vector{1, 2, 3, 0});
+  CHECK(exec::trampoline_scheduler::statistics().deferred_starts == 0);
+}
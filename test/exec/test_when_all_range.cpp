@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2023 NVIDIA Corporation
+ *
+ * Licensed under the Apache License Version 2.0 with LLVM Exceptions
+ * (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ *   https://llvm.org/LICENSE.txt
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch2/catch.hpp>
+#include <exec/when_all_range.hpp>
+#include <exec/static_thread_pool.hpp>
+#include <test_common/schedulers.hpp>
+#include <test_common/receivers.hpp>
+#include <test_common/type_helpers.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace ex = stdexec;
+
+namespace {
+  auto make_int_senders(int n) {
+    std::vector<decltype(ex::just(0))> senders;
+    for (int i = 0; i < n; ++i) {
+      senders.push_back(ex::just(i));
+    }
+    return senders;
+  }
+
+  std::vector<int> iota_vector(int n) {
+    std::vector<int> result(n);
+    std::iota(result.begin(), result.end(), 0);
+    return result;
+  }
+}
+
+TEST_CASE("when_all_range returns a sender", "[adaptors][when_all_range]") {
+  auto snd = exec::when_all_range(make_int_senders(3));
+  static_assert(ex::sender<decltype(snd)>);
+  static_assert(ex::sender_in<decltype(snd), empty_env>);
+  (void) snd;
+}
+
+TEST_CASE("when_all_range collects the values in order", "[adaptors][when_all_range]") {
+  auto snd = exec::when_all_range(make_int_senders(5));
+  wait_for_value(std::move(snd), iota_vector(5));
+}
+
+TEST_CASE("when_all_range of an empty range completes immediately", "[adaptors][when_all_range]") {
+  auto snd = exec::when_all_range(make_int_senders(0));
+  wait_for_value(std::move(snd), std::vector<int>{});
+}
+
+TEST_CASE("when_all_range of void senders sends no values", "[adaptors][when_all_range]") {
+  int count = 0;
+  auto increment = [&count] {
+    ++count;
+  };
+  std::vector<decltype(ex::just() | ex::then(increment))> senders;
+  for (int i = 0; i < 4; ++i) {
+    senders.push_back(ex::just() | ex::then(increment));
+  }
+  auto snd = exec::when_all_range(std::move(senders));
+  check_val_types<type_array<type_array<>>>(snd);
+  auto op = ex::connect(std::move(snd), expect_void_receiver{});
+  ex::start(op);
+  CHECK(count == 4);
+}
+
+TEST_CASE("when_all_range with move-only values", "[adaptors][when_all_range]") {
+  std::vector<decltype(ex::just(movable(0)))> senders;
+  senders.push_back(ex::just(movable(1)));
+  senders.push_back(ex::just(movable(2)));
+  auto [values] = ex::sync_wait(exec::when_all_range(std::move(senders))).value();
+  REQUIRE(values.size() == 2);
+  CHECK(values[0] == movable(1));
+  CHECK(values[1] == movable(2));
+}
+
+TEST_CASE("when_all_range forwards errors from the children", "[adaptors][when_all_range]") {
+  auto throw_on_3 = [](int i) {
+    if (i == 3) {
+      throw std::logic_error("3");
+    }
+    return i;
+  };
+  std::vector<decltype(ex::just(0) | ex::then(throw_on_3))> senders;
+  for (int i = 0; i < 5; ++i) {
+    senders.push_back(ex::just(i) | ex::then(throw_on_3));
+  }
+  auto op = ex::connect(exec::when_all_range(std::move(senders)), expect_error_receiver{});
+  ex::start(op);
+}
+
+TEST_CASE(
+  "when_all_range completes with stopped if a child is stopped",
+  "[adaptors][when_all_range]") {
+  stopped_scheduler sched;
+  std::vector<decltype(ex::schedule(sched))> senders(3, ex::schedule(sched));
+  auto op = ex::connect(exec::when_all_range(std::move(senders)), expect_stopped_receiver{});
+  ex::start(op);
+}
+
+TEST_CASE("when_all_range runs the children on a thread pool", "[adaptors][when_all_range]") {
+  exec::static_thread_pool pool{4};
+  auto sched = pool.get_scheduler();
+  auto square = [](int i) {
+    return i * i;
+  };
+  std::vector<decltype(ex::transfer_just(sched, 0) | ex::then(square))> senders;
+  for (int i = 0; i < 100; ++i) {
+    senders.push_back(ex::transfer_just(sched, i) | ex::then(square));
+  }
+  auto [values] = ex::sync_wait(exec::when_all_range(std::move(senders))).value();
+  REQUIRE(values.size() == 100);
+  for (int i = 0; i < 100; ++i) {
+    CHECK(values[i] == i * i);
+  }
+}
+
+TEST_CASE("when_all_range bounds the number of children in flight", "[adaptors][when_all_range]") {
+  exec::static_thread_pool pool{4};
+  auto sched = pool.get_scheduler();
+  std::atomic<int> in_flight{0};
+  std::atomic<int> max_in_flight{0};
+  auto work = [&](int i) {
+    int now = ++in_flight;
+    int prev = max_in_flight.load();
+    while (prev < now && !max_in_flight.compare_exchange_weak(prev, now)) {
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+    --in_flight;
+    return i;
+  };
+  std::vector<decltype(ex::transfer_just(sched, 0) | ex::then(work))> senders;
+  for (int i = 0; i < 50; ++i) {
+    senders.push_back(ex::transfer_just(sched, i) | ex::then(work));
+  }
+  auto [values] = ex::sync_wait(exec::when_all_range(std::move(senders), 2)).value();
+  CHECK(values == iota_vector(50));
+  CHECK(max_in_flight.load() <= 2);
+}
+
+TEST_CASE(
+  "when_all_range with bounded concurrency loops over inline children",
+  "[adaptors][when_all_range]") {
+  // Would overflow the stack if every inline completion started the next child recursively.
+  auto snd = exec::when_all_range(make_int_senders(100'000), 1);
+  auto [values] = ex::sync_wait(std::move(snd)).value();
+  CHECK(values == iota_vector(100'000));
+}
+
+TEST_CASE("when_all_range rejects a max_concurrency of zero", "[adaptors][when_all_range]") {
+  CHECK_THROWS_AS(exec::when_all_range(make_int_senders(3), 0), std::invalid_argument);
+}
@@ -17,11 +17,15 @@
 #include <catch2/catch.hpp>
 #include <exec/when_any.hpp>
 #include <exec/single_thread_context.hpp>
+#include <exec/static_thread_pool.hpp>
 #include <test_common/schedulers.hpp>
 #include <test_common/receivers.hpp>
 #include <test_common/senders.hpp>
 #include <test_common/type_helpers.hpp>
 
+#include <algorithm>
+#include <vector>
+
 namespace ex = stdexec;
 
 TEST_CASE("when_ny returns a sender", "[adaptors][when_any]") {
@@ -210,3 +214,78 @@ TEST_CASE("when_any completion signatures", "[adaptors][when_any]") {
         set_error_t(std::exception_ptr)>>>);
   // wait_for_value(std::move(snd), movable(42));
 }
+
+TEST_CASE("when_any over a range completes with the first child", "[adaptors][when_any]") {
+  int index = 0;
+  auto set_index = [&index](int i) {
+    return [&index, i] {
+      index = i;
+    };
+  };
+  std::vector<decltype(completes_if{false} | ex::then(set_index(0)))> senders;
+  for (int i = 0; i < 3; ++i) {
+    senders.push_back(completes_if{i == 1} | ex::then(set_index(i)));
+  }
+  ex::sync_wait(exec::when_any(std::move(senders)));
+  CHECK(index == 1);
+}
+
+TEST_CASE("when_any over an empty range completes with stopped", "[adaptors][when_any]") {
+  std::vector<decltype(ex::just(1))> senders;
+  auto op = ex::connect(exec::when_any(std::move(senders)), expect_stopped_receiver{});
+  ex::start(op);
+}
+
+TEST_CASE("when_first_k completes with the first k values", "[adaptors][when_any]") {
+  std::vector<decltype(ex::just(0))> senders;
+  for (int i = 0; i < 5; ++i) {
+    senders.push_back(ex::just(i));
+  }
+  wait_for_value(exec::when_first_k(3, std::move(senders)), std::vector<int>{0, 1, 2});
+}
+
+TEST_CASE("when_first_k stops the remaining children", "[adaptors][when_any]") {
+  std::vector<completes_if> senders{
+    completes_if{false}, completes_if{true}, completes_if{false}, completes_if{true}};
+  auto op = ex::connect(exec::when_first_k(2, std::move(senders)), expect_void_receiver{});
+  ex::start(op);
+}
+
+TEST_CASE("when_first_k tolerates failures while k is reachable", "[adaptors][when_any]") {
+  auto fail_on_odd = [](int i) {
+    if (i % 2) {
+      throw std::logic_error("odd");
+    }
+    return i;
+  };
+  std::vector<decltype(ex::just(0) | ex::then(fail_on_odd))> senders;
+  for (int i = 0; i < 6; ++i) {
+    senders.push_back(ex::just(i) | ex::then(fail_on_odd));
+  }
+  wait_for_value(exec::when_first_k(3, senders), std::vector<int>{0, 2, 4});
+
+  auto op = ex::connect(exec::when_first_k(4, senders), expect_error_receiver{});
+  ex::start(op);
+}
+
+TEST_CASE("when_first_k rejects k greater than the number of senders", "[adaptors][when_any]") {
+  std::vector<decltype(ex::just(0))> senders{ex::just(0), ex::just(1)};
+  CHECK_THROWS_AS(exec::when_first_k(3, senders), std::invalid_argument);
+  wait_for_value(exec::when_first_k(2, senders), std::vector<int>{0, 1});
+}
+
+TEST_CASE("when_first_k runs the children on a thread pool", "[adaptors][when_any]") {
+  exec::static_thread_pool pool{4};
+  auto sched = pool.get_scheduler();
+  auto identity = [](int i) {
+    return i;
+  };
+  std::vector<decltype(ex::transfer_just(sched, 0) | ex::then(identity))> senders;
+  for (int i = 0; i < 20; ++i) {
+    senders.push_back(ex::transfer_just(sched, i) | ex::then(identity));
+  }
+  auto [values] = ex::sync_wait(exec::when_first_k(5, std::move(senders))).value();
+  REQUIRE(values.size() == 5);
+  std::sort(values.begin(), values.end());
+  CHECK(std::unique(values.begin(), values.end()) == values.end());
+}
@@ -19,6 +19,7 @@
 #include <test_common/schedulers.hpp>
 #include <test_common/receivers.hpp>
 #include <test_common/type_helpers.hpp>
+#include <exec/env.hpp>
 
 namespace ex = stdexec;
 
@@ -202,6 +203,32 @@ TEST_CASE("when_all cancels remaining children if error is detected", "[adaptors
   CHECK(cancelled);
 }
 
+TEST_CASE(
+  "when_all of inline children completes with stopped if stop was already requested",
+  "[adaptors][when_all]") {
+  ex::in_place_stop_source stop_source;
+  stop_source.request_stop();
+  ex::sender auto snd = exec::write(
+    ex::when_all(ex::just(2), ex::just(3)),
+    exec::with(ex::get_stop_token, stop_source.get_token()));
+  auto op = ex::connect(std::move(snd), expect_stopped_receiver{});
+  ex::start(op);
+}
+
+TEST_CASE(
+  "when_all only hands out a stop token when children may complete asynchronously",
+  "[adaptors][when_all]") {
+  ex::sender auto inline_snd = ex::when_all(ex::just(), ex::read(ex::get_stop_token));
+  auto [inline_token] = ex::sync_wait(std::move(inline_snd)).value();
+  CHECK_FALSE(inline_token.stop_possible());
+
+  inline_scheduler sched;
+  ex::sender auto async_snd = ex::when_all(
+    ex::schedule(sched), ex::read(ex::get_stop_token));
+  auto [async_token] = ex::sync_wait(std::move(async_snd)).value();
+  CHECK(async_token.stop_possible());
+}
+
 TEST_CASE("when_all cancels remaining children if cancel is detected", "[adaptors][when_all]") {
   stopped_scheduler stopped_sched;
   impulse_scheduler sched;